@@ -18,13 +18,16 @@
 #ifndef ROOT_TG4RootDetectorConstruction
 #define ROOT_TG4RootDetectorConstruction
 
+#include "G4LogicalVolume.hh"
 #include "G4RotationMatrix.hh"
+#include "G4VPhysicalVolume.hh"
 #include "G4VUserDetectorConstruction.hh"
 
 #include "TGeoManager.h"
 #include "TGeoNode.h"
 
 #include <unordered_map>
+#include <vector>
 
 class TObjArray;
 class TGeoManager;
@@ -91,19 +94,45 @@ class TG4RootDetectorConstruction : public G4VUserDetectorConstruction
   typedef G4PVolumeMap_t::value_type G4PVolumeVal_t;
   G4PVolumeMap_t fG4PVolumeMap; //!< map of G4 physical volumes
 
-  /// the map from G4VPhysicalVolume to TGeoNode
-  typedef std::unordered_map<const G4VPhysicalVolume*, TGeoNode*> PVolumeMap_t;
-  /// the constant iterator for the map from G4VPhysicalVolume to TGeoNode
-  typedef PVolumeMap_t::const_iterator PVolumeIt_t;
-  /// the value type for the map from G4VPhysicalVolume to TGeoNode
-  typedef PVolumeMap_t::value_type PVolumeVal_t;
-  PVolumeMap_t fPVolumeMap; //!< map of TGeo volumes
+  std::vector<TGeoNode*> fPVNodes; //!< nodes indexed by PV instance ID
+  /// The index of the node in the daughters list of its mother volume,
+  /// indexed by the G4 physical volume instance ID (-1 if not known)
+  std::vector<Int_t> fDaughterIndices;
+  /// The flags of G4 logical volumes whose subtrees are navigated with
+  /// the native G4Navigator, indexed by the logical volume instance ID
+  std::vector<char> fNativeVolumes;
+
+  /// The store-independent data of a node placement, computed in
+  /// the parallel conversion phase
+  struct NodeRecord
+  {
+    G4ThreeVector fTranslation;      ///< translation
+    G4RotationMatrix* fRotation = 0; ///< rotation (0 if no rotation)
+    G4String fName;                  ///< physical volume name
+    G4int fCopyNo = 0;               ///< copy number
+  };
+
+  /// Minimum number of nodes per thread in the parallel conversion phase
+  static const Int_t fgkMinNodesPerThread;
+
+  Int_t fNofConversionThreads; ///< Number of threads used in the parallel
+                               /// conversion phase (0 = hardware concurrency)
+
+  void AddNode(TGeoNode* node, G4VPhysicalVolume* pvol);
+  void CreateDaughterIndices();
+  void ComputeNodeRecords(
+    const std::vector<TGeoNode*>& nodes, std::vector<NodeRecord>& records);
+  NodeRecord ComputeNodeRecord(TGeoNode* node);
+  G4VPhysicalVolume* CreateG4PhysicalVolume(
+    TGeoNode* node, const NodeRecord& record);
 
  protected:
   Bool_t fIsConstructed;                    ///< flag Construct() called
   TGeoManager* fGeometry;                   ///< TGeo geometry manager
   G4VPhysicalVolume* fTopPV;                ///< World G4 physical volume
   TVirtualUserPostDetConstruction* fSDInit; ///< Sensitive detector hook
+  Int_t fVerboseLevel; ///< Verbosity level (the conversion times are
+                       /// printed if > 0)
   // Geometry creators
   void CreateG4LogicalVolumes();
   void CreateG4Materials();
@@ -113,6 +142,7 @@ class TG4RootDetectorConstruction : public G4VUserDetectorConstruction
   G4VSolid* CreateG4Solid(TGeoShape* shape);
   G4LogicalVolume* CreateG4LogicalVolume(TGeoVolume* vol);
   G4VPhysicalVolume* CreateG4PhysicalVolume(TGeoNode* node);
+  void CollectNodes(std::vector<TGeoNode*>& nodes);
   G4Material* CreateG4Material(const TGeoMaterial* mat);
   G4RotationMatrix* CreateG4Rotation(const TGeoMatrix* matrix);
   G4Element* CreateG4Element(TGeoElement* elem);
@@ -135,11 +165,38 @@ class TG4RootDetectorConstruction : public G4VUserDetectorConstruction
   TGeoVolume* GetVolume(const G4LogicalVolume* g4vol) const;
   G4VPhysicalVolume* GetG4VPhysicalVolume(const TGeoNode* node) const;
   TGeoNode* GetNode(const G4VPhysicalVolume* g4vol) const;
+  /// Return the index of the node mapped to the G4 physical volume in
+  /// the daughters list of its mother volume (-1 if not known)
+  Int_t GetDaughterIndex(const G4VPhysicalVolume* g4pvol) const
+  {
+    size_t pvId = g4pvol->GetInstanceID();
+    return (pvId < fDaughterIndices.size()) ? fDaughterIndices[pvId] : -1;
+  }
+  /// Return true if some volumes are navigated with the native G4Navigator
+  Bool_t HasNativeNavigation() const { return !fNativeVolumes.empty(); }
+  /// Return true if the subtree of the G4 logical volume is navigated with
+  /// the native G4Navigator
+  Bool_t IsNativeNavigation(const G4LogicalVolume* g4vol) const
+  {
+    size_t lvId = g4vol->GetInstanceID();
+    return lvId < fNativeVolumes.size() && fNativeVolumes[lvId];
+  }
   /// Return the sensitive detector hook
   TVirtualUserPostDetConstruction* GetSDInit() const { return fSDInit; }
   /// Return the flag Construct() called
   Bool_t IsConstructed() const { return fIsConstructed; }
 
+  /// Set the verbosity level (the conversion times are printed if > 0)
+  void SetVerboseLevel(Int_t level) { fVerboseLevel = level; }
+  /// Set the number of threads used in the parallel conversion phase
+  /// (0 = hardware concurrency)
+  void SetNofConversionThreads(Int_t nofThreads)
+  {
+    fNofConversionThreads = nofThreads;
+  }
+
+  Bool_t SetNativeNavigation(const char* volName);
+  Long64_t GetMemoryUsage() const;
   void Initialize(TVirtualUserPostDetConstruction* sdinit = 0);
 
   //   ClassDef(TG4RootDetectorConstruction,0)  // Class creating a G4 gometry
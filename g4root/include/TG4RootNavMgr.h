@@ -44,6 +44,8 @@ class TG4RootNavMgr : public TObject
   TVirtualUserPostDetConstruction* fPostDetDetConstruction; ///< User defined
                                                             /// initialization
   Bool_t fConnected; ///< Flags connection to G4
+  Bool_t fOwnsDetConstruction; ///< Flags ownership of the detector
+                               /// construction (shared by worker instances)
 
   TG4RootNavMgr();
   TG4RootNavMgr(
@@ -18,6 +18,8 @@
 #define ROOT_TG4RootNavigator
 
 #include <functional>
+#include <map>
+#include <vector>
 
 #include "G4Navigator.hh"
 
@@ -35,11 +37,88 @@ class G4TrackingManager;
 /// this class by invoking the corresponding functionality of ROOT
 /// geometry modeler.
 ///
+/// The subtrees of the volumes selected in TG4RootDetectorConstruction
+/// (SetNativeNavigation()) are navigated by the G4Navigator base class
+/// on the converted G4 geometry. The engine is switched after locating
+/// a point: the G4Navigator state is set up by a full locate,
+/// the TGeo state is synchronized with the navigation history.
+/// The time spent in ComputeStep is accumulated per navigation subtree,
+/// keyed by its root volume: the selected volume for G4Navigator, or the
+/// daughter of the world volume for TGeo; it is printed with the
+/// statistics to compare the engines per detector.
+///
 /// \author A. Gheata; CERN
 
 class TG4RootNavigator : public G4Navigator
 {
 
+ public:
+  /// \brief The navigation statistics.
+  ///
+  /// The counters are collected per thread (each worker has its own
+  /// navigator) and merged at the end of run.
+  struct Statistics
+  {
+    Long64_t fNofSteps = 0;          ///< Number of ComputeStep calls
+    Long64_t fNofZeroSteps = 0;      ///< Number of zero steps
+    Long64_t fNofForcedSteps = 0;    ///< Number of nudge steps of stuck
+                                     /// tracks (see ZeroStepPolicy)
+    Long64_t fNofLocates = 0;        ///< Number of LocateGlobalPointAndSetup
+                                     /// calls
+    Long64_t fNofRelocations = 0;    ///< Number of relocations on boundary
+    Long64_t fNofSafeties = 0;       ///< Number of safeties computed by TGeo
+    Long64_t fNofSafetyHits = 0;     ///< Number of reused safeties
+                                     /// (same point)
+    Long64_t fNofSafetySphereHits = 0; ///< Number of safeties computed
+                                       /// from the last safety sphere
+    Long64_t fNofSafeSteps = 0;      ///< Number of steps resolved within
+                                     /// the safety sphere
+    Long64_t fNofStateRestores = 0;  ///< Number of geometry state restores
+    Long64_t fNofNativeSteps = 0;    ///< Number of steps computed by
+                                     /// G4Navigator
+    Long64_t fNofNativeLocates = 0;  ///< Number of locates by G4Navigator
+    Long64_t fNofSwitches = 0;       ///< Number of switches between TGeo
+                                     /// and G4Navigator
+    Long64_t fNofTrackingThreads = 0; ///< Number of threads with tracking
+    Long64_t fMemory = 0;            ///< Estimated memory of the navigation
+                                     /// state (in bytes) of tracking threads
+
+    void Add(const Statistics& other);
+  };
+
+  /// \brief The zero step policy.
+  ///
+  /// After fMaxZeroSteps consecutive zero steps the stuck track is pushed
+  /// by a nudge step in the current volume. For each further nudge of the
+  /// same stuck track the nudge grows by fNudgeFactor (up to fMaxNudge)
+  /// and the number of zero steps before the next nudge is halved.
+  struct ZeroStepPolicy
+  {
+    Int_t fMaxZeroSteps = 40;    ///< Zero steps before the first nudge
+                                 /// (< 50 limit in G4PropagatorInField)
+    G4double fNudge = 1.e-3;     ///< The first nudge step length (mm)
+                                 /// (> 1.e-4 limit in G4PropagatorInField)
+    G4double fNudgeFactor = 10.; ///< The nudge growth factor
+    G4double fMaxNudge = 1.;     ///< The maximum nudge step length (mm)
+  };
+
+  /// \brief The timing of steps in a navigation subtree.
+  struct SubtreeTiming
+  {
+    Long64_t fNofSteps = 0; ///< Number of ComputeStep calls
+    Double_t fTime = 0.;    ///< Time spent in ComputeStep (s)
+    Bool_t fNative = kFALSE; ///< The subtree is navigated by G4Navigator
+  };
+
+  /// \brief The registry entry of stuck tracks per volume pair.
+  struct StuckEntry
+  {
+    Long64_t fNofNudges = 0; ///< Number of nudges
+    Int_t fMaxNofNudges = 0; ///< Maximum number of consecutive nudges
+                             /// of a track
+    G4ThreeVector fPosition; ///< Global position of the first nudge
+  };
+
  protected:
   TGeoManager* fGeometry;                        ///< TGeo geometry manager
   TGeoNavigator* fNavigator;                     ///< TGeo navigator
@@ -50,14 +129,54 @@ class TG4RootNavigator : public G4Navigator
   Bool_t fStepExiting;       ///< Next step is exiting current volume
   G4ThreeVector fNextPoint;  ///< Crossing point with next boundary
   G4ThreeVector fSafetyOrig; ///< Last computed safety origin
-  G4double fLastSafety;      ///< Last computed safety
+  G4double fLastSafety;      ///< Last computed safety (the radius of the
+                             /// safety sphere around fSafetyOrig)
   Int_t fNzeroSteps;         ///< Number of zero steps in ComputeStep
   G4TrackingManager* fG4TrackingManager; ///< Store pointer to G4TrackingManager
   std::function<Bool_t(Int_t)> fRestoreGeoStateFunction; ///< Function pointer
                                                          /// to restore geometry
+  std::vector<TGeoNode*> fBranchNodes; ///< Mirror of the synchronized
+                                       /// branch: TGeo nodes per level
+  std::vector<G4VPhysicalVolume*> fBranchVolumes; ///< Mirror of the
+                                                  /// synchronized branch:
+                                                  /// G4 volumes per level
+  Statistics fStatistics; ///< Navigation statistics of this thread
+  Bool_t fNativeMode; ///< The current volume is navigated by G4Navigator
+  Bool_t fNativeStep; ///< The last step was computed by G4Navigator
+  Int_t fNofNudges;   ///< Number of consecutive nudges of the stuck track
+  /// The registry of stuck tracks of this thread per pair of the current
+  /// and the next volume
+  std::map<std::pair<const G4VPhysicalVolume*, const G4VPhysicalVolume*>,
+    StuckEntry>
+    fStuckRegistry;
+  /// The step timings of this thread per navigation subtree root volume
+  std::map<const G4LogicalVolume*, SubtreeTiming> fSubtreeTimings;
+  const G4LogicalVolume* fSubtreeRoot; ///< The current subtree root volume
+  SubtreeTiming* fSubtreeTiming; ///< The timing of the current subtree
+
  private:
+  static Statistics fgMergedStatistics; ///< Statistics merged from all threads
+  static Long64_t fgSharedMemory; ///< Estimated memory of the lookup tables
+                                  /// shared by all threads (in bytes)
+  static ZeroStepPolicy fgZeroStepPolicy; ///< The zero step policy
+  /// The registry of stuck tracks merged from all threads (by volume names)
+  static std::map<std::pair<G4String, G4String>, StuckEntry>
+    fgMergedStuckRegistry;
+  /// The step timings merged from all threads (by subtree root volume names)
+  static std::map<G4String, SubtreeTiming> fgMergedSubtreeTimings;
+
+
   G4VPhysicalVolume* SynchronizeHistory();
   TGeoNode* SynchronizeGeoManager();
+  G4VPhysicalVolume* GetBranchVolume(Int_t level, TGeoNode* node);
+  TGeoNode* GetBranchNode(Int_t level, G4VPhysicalVolume* pvol);
+  Int_t GetDaughterIndex(G4VPhysicalVolume* pvol, TGeoNode* node);
+  const G4LogicalVolume* GetSubtreeRoot(Bool_t& native) const;
+  void CreateTGeoNavigator();
+  G4double NudgeStep(const G4ThreeVector& point);
+  G4VPhysicalVolume* SwitchNavigation(const G4ThreeVector& point,
+    const G4ThreeVector* direction, G4bool ignoreDirection,
+    G4VPhysicalVolume* target);
 
  public:
   TG4RootNavigator();
@@ -113,6 +232,18 @@ class TG4RootNavigator : public G4Navigator
   void SetGeometryRestoreFunction(
     std::function<Bool_t(Int_t)> restoreGeoStateFunction);
 
+  /// Return the navigation statistics of this thread
+  const Statistics& GetStatistics() const { return fStatistics; }
+  /// Clear the navigation statistics of this thread
+  void ClearStatistics() { fStatistics = Statistics(); }
+  void MergeStatistics();
+  Long64_t GetMemoryUsage() const;
+  static void PrintStatistics();
+
+  static void SetZeroStepPolicy(const ZeroStepPolicy& policy);
+  /// Return the zero step policy
+  static const ZeroStepPolicy& GetZeroStepPolicy() { return fgZeroStepPolicy; }
+
   //   ClassDef(TG4RootNavigator,0)  // Class defining a G4Navigator based on
   //   ROOT geometry
 };
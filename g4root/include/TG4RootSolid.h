@@ -24,6 +24,13 @@ class TGeoShape;
 
 /// \brief GEANT4 solid implemented by a ROOT shape.
 ///
+/// For TGeoBBox, TGeoTube, TGeoTubeSeg, TGeoTrd1 and TGeoTrd2 shapes
+/// the navigation functions are implemented directly with the shape
+/// parameters converted in G4 units at construction; boxes and trapezoids
+/// are handled as convex polyhedra defined by their planes. The ray
+/// distances for tube segments and all other shapes are computed via
+/// the TGeoShape functions.
+///
 /// Visualization methods not implemented.
 ///
 /// \author A. Gheata; CERN
@@ -32,13 +39,51 @@ class TG4RootSolid : public G4VSolid
 {
 
  protected:
-  TGeoShape* fShape; ///< TGeo associated shape
+  /// The shape types with a specialised implementation
+  enum EShapeType
+  {
+    kGeneric, ///< generic shape (TGeoShape functions)
+    kConvex,  ///< convex polyhedron (TGeoBBox, TGeoTrd1, TGeoTrd2)
+    kTube,    ///< tube (TGeoTube, full TGeoTubeSeg)
+    kTubeSeg  ///< tube segment (TGeoTubeSeg)
+  };
+
+  TGeoShape* fShape;       ///< TGeo associated shape
+  EShapeType fShapeType;   ///< Type of the specialised implementation
+  G4int fNofPlanes;        ///< Number of planes (kConvex)
+  G4double fPlanes[6][4];  ///< Planes a*x+b*y+c*z+d = 0, with the unit
+                           /// normal pointing outside (kConvex)
+  G4double fRmin;          ///< Inner radius (kTube, kTubeSeg)
+  G4double fRmax;          ///< Outer radius (kTube, kTubeSeg)
+  G4double fDz;            ///< Half length in z (kTube, kTubeSeg)
+  G4double fPhi1;          ///< Starting phi (kTubeSeg)
+  G4double fDphi;          ///< Phi range (kTubeSeg)
+  G4ThreeVector fBoxMin;   ///< Bounding box lower limits
+  G4ThreeVector fBoxMax;   ///< Bounding box upper limits
+  G4double fCubicVolume;   ///< Cached cubic volume (< 0 if not computed)
+
+ private:
+  void InitShapeType();
+  void AddPlane(G4double a, G4double b, G4double c, G4double d);
+  G4double ConvexDistance(const G4ThreeVector& p) const;
+  G4double ConvexDistanceToIn(
+    const G4ThreeVector& p, const G4ThreeVector& v) const;
+  G4double ConvexDistanceToOut(const G4ThreeVector& p, const G4ThreeVector& v,
+    const G4bool calcNorm, G4bool* validNorm, G4ThreeVector* n) const;
+  G4double TubeDistance(const G4ThreeVector& p) const;
+  G4double TubeDistanceToIn(
+    const G4ThreeVector& p, const G4ThreeVector& v) const;
+  G4double TubeDistanceToOut(const G4ThreeVector& p, const G4ThreeVector& v,
+    const G4bool calcNorm, G4bool* validNorm, G4ThreeVector* n) const;
 
  public:
-  TG4RootSolid() : G4VSolid(""), fShape(0) {} ///< Default ctor
+  TG4RootSolid();
   TG4RootSolid(TGeoShape* shape);
   virtual ~TG4RootSolid() {} ///< Destructor
 
+#if G4VERSION_NUMBER >= 1030
+  virtual void BoundingLimits(G4ThreeVector& pMin, G4ThreeVector& pMax) const;
+#endif
   virtual G4bool CalculateExtent(const EAxis pAxis,
     const G4VoxelLimits& pVoxelLimit, const G4AffineTransform& pTransform,
     G4double& pMin, G4double& pMax) const;
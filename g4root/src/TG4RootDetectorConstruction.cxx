@@ -28,6 +28,7 @@
 #include "G4PhysicalVolumeStore.hh"
 #include "G4SolidStore.hh"
 #include "G4SystemOfUnits.hh"
+#include "G4Timer.hh"
 #include "G4UnitsTable.hh"
 
 #include "TGeoManager.h"
@@ -35,15 +36,47 @@
 
 #include "TList.h"
 
+#include <algorithm>
+#include <thread>
+#include <unordered_set>
+
 // ClassImp(TG4RootDetectorConstruction)
 
+
+namespace
+{
+/// Estimated memory of the vector (in bytes)
+template <typename T>
+size_t VectorMemory(const std::vector<T>& vector)
+{
+  return vector.capacity() * sizeof(T);
+}
+
+/// Estimated memory of the unordered map (in bytes): the nodes
+/// (value and next pointer, cached hash) and the buckets
+template <typename Map>
+size_t MapMemory(const Map& map)
+{
+  return map.size() * (sizeof(typename Map::value_type) + 2 * sizeof(void*)) +
+         map.bucket_count() * sizeof(void*);
+}
+} // namespace
+
+const Int_t TG4RootDetectorConstruction::fgkMinNodesPerThread = 10000;
+
 //______________________________________________________________________________
 TG4RootDetectorConstruction::TG4RootDetectorConstruction()
   : G4VUserDetectorConstruction(),
+    fG4PVolumeMap(),
+    fPVNodes(),
+    fDaughterIndices(),
+    fNativeVolumes(),
+    fNofConversionThreads(0),
     fIsConstructed(kFALSE),
     fGeometry(0),
     fTopPV(0),
-    fSDInit(0)
+    fSDInit(0),
+    fVerboseLevel(0)
 {
   /// Dummy ctor.
 }
@@ -51,10 +84,16 @@ TG4RootDetectorConstruction::TG4RootDetectorConstruction()
 //______________________________________________________________________________
 TG4RootDetectorConstruction::TG4RootDetectorConstruction(TGeoManager* geom)
   : G4VUserDetectorConstruction(),
+    fG4PVolumeMap(),
+    fPVNodes(),
+    fDaughterIndices(),
+    fNativeVolumes(),
+    fNofConversionThreads(0),
     fIsConstructed(kFALSE),
     fGeometry(geom),
     fTopPV(0),
-    fSDInit(0)
+    fSDInit(0),
+    fVerboseLevel(0)
 {
   /// Default ctor.
   if (!geom || !geom->IsClosed()) {
@@ -149,9 +188,19 @@ G4VPhysicalVolume* TG4RootDetectorConstruction::Construct()
   if (fTopPV) return fTopPV;
   // Convert reflections via TGeo reflection factory
   fGeometry->ConvertReflections();
+  G4Timer timer;
+  timer.Start();
   CreateG4Materials();
+  timer.Stop();
+  if (fVerboseLevel > 0)
+    G4cout << "     Materials conversion time: " << timer << G4endl;
   //   CreateG4LogicalVolumes();
   CreateG4PhysicalVolumes();
+  timer.Start();
+  CreateDaughterIndices();
+  timer.Stop();
+  if (fVerboseLevel > 0)
+    G4cout << "     Daughter indices creation time: " << timer << G4endl;
   TG4RootNavMgr* navMgr = TG4RootNavMgr::GetInstance(fGeometry);
   TG4RootNavigator* nav = navMgr->GetNavigator();
   nav->SetDetectorConstruction(this);
@@ -189,20 +238,123 @@ void TG4RootDetectorConstruction::CreateG4LogicalVolumes()
 void TG4RootDetectorConstruction::CreateG4PhysicalVolumes()
 {
   /// Create physical volumes for GEANT4 based on TGeo hierarchy.
-  TGeoNode* node = fGeometry->GetTopNode();
-  fTopPV = CreateG4PhysicalVolume(node);
+  /// The conversion is done in three phases:
+  /// - serial:   collect the nodes in the order of the hierarchy traversal
+  /// - parallel: compute the store-independent node records (placement
+  ///             in G4 units, name, copy number)
+  /// - serial:   create the G4 solids, logical and physical volumes, which
+  ///             are registered in the G4 stores, in the order of the
+  ///             collected nodes (so the G4 hierarchy does not depend on
+  ///             the number of threads)
+  G4Timer timer;
+  timer.Start();
+  std::vector<TGeoNode*> nodes;
+  CollectNodes(nodes);
+  timer.Stop();
+  if (fVerboseLevel > 0)
+    G4cout << "     Nodes collection time (" << nodes.size()
+           << " nodes): " << timer << G4endl;
+
+  timer.Start();
+  std::vector<NodeRecord> records(nodes.size());
+  ComputeNodeRecords(nodes, records);
+  timer.Stop();
+  if (fVerboseLevel > 0)
+    G4cout << "     Node records computation time: " << timer << G4endl;
+
+  timer.Start();
+  fTopPV = CreateG4PhysicalVolume(nodes[0], records[0]);
+  for (size_t i = 1; i < nodes.size(); ++i) {
+    CreateG4PhysicalVolume(nodes[i], records[i]);
+  }
+  timer.Stop();
+  if (fVerboseLevel > 0)
+    G4cout << "     Volumes creation time: " << timer << G4endl;
+
+  G4cout
+    << "===> GEANT4 physical volumes created and mapped to TGeo hierarchy..."
+    << G4endl;
+}
+
+//______________________________________________________________________________
+void TG4RootDetectorConstruction::CollectNodes(std::vector<TGeoNode*>& nodes)
+{
+  /// Collect the nodes in the order of the hierarchy traversal, starting
+  /// from the top node. The daughters of each volume are collected only
+  /// when the volume is met for the first time, the already expanded
+  /// branches are skipped.
+  nodes.push_back(fGeometry->GetTopNode());
+  std::unordered_set<const TGeoVolume*> expandedVolumes;
+  expandedVolumes.insert(fGeometry->GetTopVolume());
   TGeoIterator next(fGeometry->GetTopVolume());
-  TGeoNode* mother;
+  TGeoNode *node, *mother;
   while ((node = next())) {
     mother = next.GetNode(next.GetLevel() - 1);
     if (mother && node->GetMotherVolume() != mother->GetVolume())
       node->SetMotherVolume(mother->GetVolume());
-    CreateG4PhysicalVolume(node);
+    nodes.push_back(node);
+    if (!expandedVolumes.insert(node->GetVolume()).second) next.Skip();
   }
+}
 
-  G4cout
-    << "===> GEANT4 physical volumes created and mapped to TGeo hierarchy..."
-    << G4endl;
+//______________________________________________________________________________
+void TG4RootDetectorConstruction::ComputeNodeRecords(
+  const std::vector<TGeoNode*>& nodes, std::vector<NodeRecord>& records)
+{
+  /// Compute the records of the given nodes using a pool of threads.
+  /// Only the node matrices and names are read, nothing is registered in
+  /// the G4 stores. The division nodes (TGeoNodeOffset), whose matrix is
+  /// computed by their pattern finder, are processed in the calling thread
+  /// after the pool has finished.
+  Int_t nofNodes = nodes.size();
+  Int_t nofThreads = fNofConversionThreads;
+  if (nofThreads <= 0) nofThreads = std::thread::hardware_concurrency();
+  nofThreads = std::min(nofThreads, nofNodes / fgkMinNodesPerThread);
+  if (nofThreads < 1) nofThreads = 1;
+
+  auto compute = [&](Int_t first, Int_t last) {
+    for (Int_t i = first; i < last; ++i) {
+      if (nofThreads > 1 && nodes[i]->IsOffset()) continue;
+      records[i] = ComputeNodeRecord(nodes[i]);
+    }
+  };
+
+  if (nofThreads == 1) {
+    compute(0, nofNodes);
+    return;
+  }
+
+  Int_t chunk = (nofNodes + nofThreads - 1) / nofThreads;
+  std::vector<std::thread> threads;
+  for (Int_t i = 1; i < nofThreads; ++i) {
+    threads.emplace_back(
+      compute, i * chunk, std::min(nofNodes, (i + 1) * chunk));
+  }
+  compute(0, std::min(nofNodes, chunk));
+  for (auto& thread : threads) thread.join();
+
+  for (Int_t i = 0; i < nofNodes; ++i) {
+    if (nodes[i]->IsOffset()) records[i] = ComputeNodeRecord(nodes[i]);
+  }
+  if (fVerboseLevel > 0)
+    G4cout << "     Node records computed with " << nofThreads << " threads"
+           << G4endl;
+}
+
+//______________________________________________________________________________
+TG4RootDetectorConstruction::NodeRecord
+TG4RootDetectorConstruction::ComputeNodeRecord(TGeoNode* node)
+{
+  /// Compute the node placement in G4 units, its name and copy number.
+  NodeRecord record;
+  if (node->IsOffset()) node->cd();
+  TGeoMatrix* mat = node->GetMatrix();
+  const Double_t* tr = mat->GetTranslation();
+  record.fTranslation.set(tr[0] * cm, tr[1] * cm, tr[2] * cm);
+  record.fRotation = CreateG4Rotation(mat);
+  record.fName = node->GetVolume()->GetName();
+  record.fCopyNo = node->GetNumber();
+  return record;
 }
 
 //______________________________________________________________________________
@@ -290,14 +442,27 @@ G4VPhysicalVolume* TG4RootDetectorConstruction::CreateG4PhysicalVolume(
 {
   /// Create a G4VPhysicalVolume object based on a TGeo node.
   if (!node) return NULL;
-  node->cd();
   G4VPhysicalVolume* pPhysicalVolume = GetG4VPhysicalVolume(node);
   if (pPhysicalVolume) return pPhysicalVolume;
-  TGeoMatrix* mat = node->GetMatrix();
-  const Double_t* tr = mat->GetTranslation();
-  G4ThreeVector tlate(tr[0] * cm, tr[1] * cm, tr[2] * cm);
-  G4RotationMatrix* pRot = CreateG4Rotation(mat);
-  G4String pName(node->GetVolume()->GetName());
+  return CreateG4PhysicalVolume(node, ComputeNodeRecord(node));
+}
+
+//______________________________________________________________________________
+G4VPhysicalVolume* TG4RootDetectorConstruction::CreateG4PhysicalVolume(
+  TGeoNode* node, const NodeRecord& record)
+{
+  /// Create a G4VPhysicalVolume object based on a TGeo node and its record
+  /// computed in ComputeNodeRecord(). The record rotation is deleted if
+  /// the volume already exists.
+  if (!node) return NULL;
+  G4VPhysicalVolume* pPhysicalVolume = GetG4VPhysicalVolume(node);
+  if (pPhysicalVolume) {
+    delete record.fRotation;
+    return pPhysicalVolume;
+  }
+  const G4ThreeVector& tlate = record.fTranslation;
+  G4RotationMatrix* pRot = record.fRotation;
+  const G4String& pName = record.fName;
   G4LogicalVolume* pCurrentLogical = CreateG4LogicalVolume(node->GetVolume());
   if (!pCurrentLogical) {
     G4ExceptionDescription description;
@@ -316,15 +481,82 @@ G4VPhysicalVolume* TG4RootDetectorConstruction::CreateG4PhysicalVolume(
       "G4Root_F005", FatalException, description);
   }
   G4bool pMany = false;
-  G4int pCopyNo = node->GetNumber();
+  G4int pCopyNo = record.fCopyNo;
 
   pPhysicalVolume = new G4PVPlacement(
     pRot, tlate, pCurrentLogical, pName, pMotherLogical, pMany, pCopyNo);
-  fG4PVolumeMap.insert(G4PVolumeVal_t(node, pPhysicalVolume));
-  fPVolumeMap.insert(PVolumeVal_t(pPhysicalVolume, node));
+  AddNode(node, pPhysicalVolume);
   return pPhysicalVolume;
 }
 
+//______________________________________________________________________________
+void TG4RootDetectorConstruction::AddNode(
+  TGeoNode* node, G4VPhysicalVolume* pvol)
+{
+  /// Add the node and its G4 physical volume in the mapping tables.
+  size_t pvId = pvol->GetInstanceID();
+  if (pvId >= fPVNodes.size()) fPVNodes.resize(pvId + 1, 0);
+  fPVNodes[pvId] = node;
+  fG4PVolumeMap[node] = pvol;
+}
+
+//______________________________________________________________________________
+void TG4RootDetectorConstruction::CreateDaughterIndices()
+{
+  /// Fill the table of the node indices in the daughters lists of their
+  /// mother volumes, so that the navigator does not need to search them
+  /// via TGeoVolume::GetIndex() when synchronizing TGeo with G4 history.
+  /// Each daughters list is traversed only once.
+  fDaughterIndices.assign(fPVNodes.size(), -1);
+  TIter next(fGeometry->GetListOfVolumes());
+  TGeoVolume* vol;
+  while ((vol = (TGeoVolume*)next())) {
+    Int_t nd = vol->GetNdaughters();
+    for (Int_t i = 0; i < nd; ++i) {
+      G4VPhysicalVolume* pvol = GetG4VPhysicalVolume(vol->GetNode(i));
+      if (!pvol) continue;
+      size_t pvId = pvol->GetInstanceID();
+      if (pvId < fDaughterIndices.size()) fDaughterIndices[pvId] = i;
+    }
+  }
+}
+
+//______________________________________________________________________________
+Bool_t TG4RootDetectorConstruction::SetNativeNavigation(const char* volName)
+{
+  /// Select the TGeo volume whose subtree will be navigated with the native
+  /// G4Navigator (using the G4 smart voxels) instead of TGeo. The G4 geometry
+  /// converted from TGeo is used by both navigators.
+  /// Must be called after Construct() and before the navigators start
+  /// tracking; return false if the volume was not converted.
+  TGeoVolume* vol = fGeometry ? fGeometry->GetVolume(volName) : 0;
+  G4LogicalVolume* g4vol = vol ? GetG4Volume(vol) : 0;
+  if (!g4vol) {
+    G4cout << "### WARNING: TG4RootDetectorConstruction: volume " << volName
+           << " not found, native navigation not set." << G4endl;
+    return kFALSE;
+  }
+  size_t lvId = g4vol->GetInstanceID();
+  if (lvId >= fNativeVolumes.size()) fNativeVolumes.resize(lvId + 1, 0);
+  fNativeVolumes[lvId] = 1;
+  G4cout << "### INFO: TG4RootDetectorConstruction: volume " << volName
+         << " will be navigated with G4Navigator" << G4endl;
+  return kTRUE;
+}
+
+//______________________________________________________________________________
+Long64_t TG4RootDetectorConstruction::GetMemoryUsage() const
+{
+  /// Return the estimated memory (in bytes) of the TGeo <-> G4 lookup tables.
+  /// The tables are filled once by Construct() and then only read,
+  /// they are shared by the navigators of all threads.
+  size_t memory = MapMemory(fG4MaterialMap) + MapMemory(fG4VolumeMap) +
+                  MapMemory(fVolumeMap) + MapMemory(fG4PVolumeMap) +
+                  VectorMemory(fPVNodes) + VectorMemory(fDaughterIndices) +
+                  VectorMemory(fNativeVolumes);
+  return memory;
+}
+
 //______________________________________________________________________________
 G4Material* TG4RootDetectorConstruction::CreateG4Material(
   const TGeoMaterial* mat)
@@ -542,7 +774,7 @@ TGeoNode* TG4RootDetectorConstruction::GetNode(
   const G4VPhysicalVolume* g4pvol) const
 {
   /// Retreive a TGeo node mapped to a G4 physical volume.
-  PVolumeIt_t it = fPVolumeMap.find(g4pvol);
-  if (it != fPVolumeMap.end()) return it->second;
+  size_t pvId = g4pvol->GetInstanceID();
+  if (pvId < fPVNodes.size()) return fPVNodes[pvId];
   return NULL;
 }
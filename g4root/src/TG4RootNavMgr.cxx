@@ -37,7 +37,8 @@ TG4RootNavMgr::TG4RootNavMgr()
     fGeometry(0),
     fNavigator(0),
     fDetConstruction(0),
-    fConnected(kFALSE)
+    fConnected(kFALSE),
+    fOwnsDetConstruction(kFALSE)
 {
   /// Dummy ctor.
 }
@@ -49,11 +50,13 @@ TG4RootNavMgr::TG4RootNavMgr(
     fGeometry(geom),
     fNavigator(0),
     fDetConstruction(detConstruction),
-    fConnected(kFALSE)
+    fConnected(kFALSE),
+    fOwnsDetConstruction(kFALSE)
 {
   /// Default ctor.
   if (!detConstruction) {
     fDetConstruction = new TG4RootDetectorConstruction(geom);
+    fOwnsDetConstruction = kTRUE;
     SetNavigator(new TG4RootNavigator());
   }
   else {
@@ -66,7 +69,7 @@ TG4RootNavMgr::~TG4RootNavMgr()
 {
   /// Destructor.
   //   if (fNavigator) delete fNavigator;
-  if (fDetConstruction) delete fDetConstruction;
+  if (fOwnsDetConstruction) delete fDetConstruction;
   fRootNavMgr = 0;
 
   G4bool isMaster = !G4Threading::IsWorkerThread();
@@ -94,7 +97,9 @@ TG4RootNavMgr* TG4RootNavMgr::GetInstance(TGeoManager* geom)
 //______________________________________________________________________________
 TG4RootNavMgr* TG4RootNavMgr::GetInstance(const TG4RootNavMgr& navMgr)
 {
-  /// Get the pointer to the singleton. If none, create one based on 'geom'.
+  /// Get the pointer to the singleton. If none, create one sharing
+  /// the geometry and the detector construction (with its lookup tables)
+  /// of the given instance.
   if (fRootNavMgr) return fRootNavMgr;
   // Check if we have to create one.
   fRootNavMgr = new TG4RootNavMgr(navMgr.fGeometry, navMgr.fDetConstruction);
@@ -176,6 +181,9 @@ void TG4RootNavMgr::Initialize(
   TVirtualUserPostDetConstruction* sdinit, Int_t nthreads)
 {
   /// Construct G4 geometry based on TGeo geometry.
+  /// The TGeo thread data are allocated by ROOT for nthreads threads;
+  /// the TGeo navigators are created by worker navigators only when
+  /// their thread starts tracking.
   Info("Initialize", "Creating G4 hierarchy ...");
   if (fDetConstruction) fDetConstruction->Initialize(sdinit);
   if (nthreads > 1) gGeoManager->SetMaxThreads(nthreads);
@@ -199,8 +207,9 @@ void TG4RootNavMgr::LocateGlobalPointAndSetup(Double_t* pt, Double_t* dir)
 //______________________________________________________________________________
 void TG4RootNavMgr::SetVerboseLevel(Int_t level)
 {
-  /// Set navigator verbosity level.
+  /// Set navigator and detector construction verbosity level.
   fNavigator->SetVerboseLevel(level);
+  if (fDetConstruction) fDetConstruction->SetVerboseLevel(level);
 }
 
 //______________________________________________________________________________
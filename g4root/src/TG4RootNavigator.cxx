@@ -14,13 +14,21 @@
 ///
 /// \author A. Gheata; CERN
 
+#include "TGeoCache.h"
 #include "TGeoManager.h"
+#include "TGeoMatrix.h"
+#include "TGeoNavigator.h"
 
 #include "TG4RootDetectorConstruction.h"
 #include "TG4RootNavigator.h"
 
+#include "G4AutoLock.hh"
 #include "G4SystemOfUnits.hh"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
 // ClassImp(TG4RootNavigator)
 // To get the current track in case to restore a geometry status
 #include "G4Track.hh"
@@ -28,8 +36,78 @@
 
 /// constant for conversion cm <-> mm
 static const double gCm = 1. / cm;
-static const double gZeroStepThr = 1.e-3; // >1.e-4 limit in G4PropagatorInField
-static const int gAbandonZeroSteps = 40;  // <50 limit in G4PropagatorInField
+static const int gCacheStackSize = 10;    // default TGeoNodeCache stack size
+static const int gMaxNofStuckEntries = 20; // printed stuck registry entries
+static const int gMaxNofSubtreeEntries = 20; // printed subtree timings
+
+#ifdef G4MULTITHREADED
+namespace
+{
+// Mutex to lock merging navigation statistics
+G4Mutex mergeStatisticsMutex = G4MUTEX_INITIALIZER;
+} // namespace
+#endif
+
+TG4RootNavigator::Statistics TG4RootNavigator::fgMergedStatistics;
+Long64_t TG4RootNavigator::fgSharedMemory = 0;
+TG4RootNavigator::ZeroStepPolicy TG4RootNavigator::fgZeroStepPolicy;
+std::map<std::pair<G4String, G4String>, TG4RootNavigator::StuckEntry>
+  TG4RootNavigator::fgMergedStuckRegistry;
+std::map<G4String, TG4RootNavigator::SubtreeTiming>
+  TG4RootNavigator::fgMergedSubtreeTimings;
+
+namespace
+{
+/// Return the volume name with its copy number
+G4String GetVolumeName(const G4VPhysicalVolume* pvol)
+{
+  if (!pvol) return G4String("none");
+  return pvol->GetName() + "#" + std::to_string(pvol->GetCopyNo());
+}
+
+/// Add the time spent in its scope and one step to the subtree timing
+class SubtreeTimer
+{
+ public:
+  explicit SubtreeTimer(TG4RootNavigator::SubtreeTiming* timing)
+    : fTiming(timing)
+  {
+    if (fTiming) fStart = std::chrono::steady_clock::now();
+  }
+  ~SubtreeTimer()
+  {
+    if (!fTiming) return;
+    fTiming->fNofSteps++;
+    fTiming->fTime += std::chrono::duration<Double_t>(
+      std::chrono::steady_clock::now() - fStart).count();
+  }
+
+ private:
+  TG4RootNavigator::SubtreeTiming* fTiming;
+  std::chrono::steady_clock::time_point fStart;
+};
+} // namespace
+
+//______________________________________________________________________________
+void TG4RootNavigator::Statistics::Add(const Statistics& other)
+{
+  /// Add the other statistics to this one.
+  fNofSteps += other.fNofSteps;
+  fNofZeroSteps += other.fNofZeroSteps;
+  fNofForcedSteps += other.fNofForcedSteps;
+  fNofLocates += other.fNofLocates;
+  fNofRelocations += other.fNofRelocations;
+  fNofSafeties += other.fNofSafeties;
+  fNofSafetyHits += other.fNofSafetyHits;
+  fNofSafetySphereHits += other.fNofSafetySphereHits;
+  fNofSafeSteps += other.fNofSafeSteps;
+  fNofStateRestores += other.fNofStateRestores;
+  fNofNativeSteps += other.fNofNativeSteps;
+  fNofNativeLocates += other.fNofNativeLocates;
+  fNofSwitches += other.fNofSwitches;
+  fNofTrackingThreads += other.fNofTrackingThreads;
+  fMemory += other.fMemory;
+}
 
 //______________________________________________________________________________
 TG4RootNavigator::TG4RootNavigator()
@@ -44,7 +122,17 @@ TG4RootNavigator::TG4RootNavigator()
     fLastSafety(0),
     fNzeroSteps(0),
     fG4TrackingManager(nullptr),
-    fRestoreGeoStateFunction(nullptr)
+    fRestoreGeoStateFunction(nullptr),
+    fBranchNodes(),
+    fBranchVolumes(),
+    fStatistics(),
+    fNativeMode(kFALSE),
+    fNativeStep(kFALSE),
+    fNofNudges(0),
+    fStuckRegistry(),
+    fSubtreeTimings(),
+    fSubtreeRoot(0),
+    fSubtreeTiming(0)
 {
   /// Dummy ctor.
 }
@@ -62,7 +150,17 @@ TG4RootNavigator::TG4RootNavigator(TG4RootDetectorConstruction* dc)
     fLastSafety(0),
     fNzeroSteps(0),
     fG4TrackingManager(nullptr),
-    fRestoreGeoStateFunction(nullptr)
+    fRestoreGeoStateFunction(nullptr),
+    fBranchNodes(),
+    fBranchVolumes(),
+    fStatistics(),
+    fNativeMode(kFALSE),
+    fNativeStep(kFALSE),
+    fNofNudges(0),
+    fStuckRegistry(),
+    fSubtreeTimings(),
+    fSubtreeRoot(0),
+    fSubtreeTiming(0)
 {
   /// Default ctor.
   fSafetyOrig.set(kInfinity, kInfinity, kInfinity);
@@ -87,10 +185,161 @@ void TG4RootNavigator::SetDetectorConstruction(TG4RootDetectorConstruction* dc)
       FatalException,
       "Cannot create TG4RootNavigator without closed ROOT geometry !");
   }
+  // The TGeo navigator of this thread is created at the first locate
+  // if it does not exist yet (see CreateTGeoNavigator)
   fNavigator = fGeometry->GetCurrentNavigator();
-  if (!fNavigator) fNavigator = fGeometry->AddNavigator();
   // G4cout << "Navigator created: " << fNavigator << G4endl;
   fDetConstruction = dc;
+  fBranchNodes.clear();
+  fBranchVolumes.clear();
+  fNativeMode = kFALSE;
+  fNativeStep = kFALSE;
+}
+
+//______________________________________________________________________________
+G4VPhysicalVolume* TG4RootNavigator::GetBranchVolume(
+  Int_t level, TGeoNode* node)
+{
+  /// Return the G4 physical volume mapped to the node at the given level.
+  /// The mapping is looked up only if the node differs from the one
+  /// mirrored at this level.
+  if (level >= Int_t(fBranchNodes.size())) {
+    fBranchNodes.resize(level + 1, 0);
+    fBranchVolumes.resize(level + 1, 0);
+  }
+  if (fBranchNodes[level] != node || !fBranchVolumes[level]) {
+    fBranchNodes[level] = node;
+    fBranchVolumes[level] = fDetConstruction->GetG4VPhysicalVolume(node);
+  }
+  return fBranchVolumes[level];
+}
+
+//______________________________________________________________________________
+TGeoNode* TG4RootNavigator::GetBranchNode(Int_t level, G4VPhysicalVolume* pvol)
+{
+  /// Return the node mapped to the G4 physical volume at the given level.
+  /// The mapping is looked up only if the volume differs from the one
+  /// mirrored at this level.
+  if (level >= Int_t(fBranchVolumes.size())) {
+    fBranchNodes.resize(level + 1, 0);
+    fBranchVolumes.resize(level + 1, 0);
+  }
+  if (fBranchVolumes[level] != pvol || !fBranchNodes[level]) {
+    fBranchVolumes[level] = pvol;
+    fBranchNodes[level] = fDetConstruction->GetNode(pvol);
+  }
+  return fBranchNodes[level];
+}
+
+//______________________________________________________________________________
+Int_t TG4RootNavigator::GetDaughterIndex(
+  G4VPhysicalVolume* pvol, TGeoNode* node)
+{
+  /// Return the index of the node mapped to the G4 physical volume in the
+  /// current TGeo volume, from the table precomputed by the detector
+  /// construction; the daughters list is searched only if the node
+  /// is not found in the table.
+  Int_t index = fDetConstruction->GetDaughterIndex(pvol);
+  TGeoVolume* vol = fNavigator->GetCurrentVolume();
+  if (index >= 0 && index < vol->GetNdaughters() &&
+      vol->GetNode(index) == node)
+    return index;
+  return vol->GetIndex(node);
+}
+
+//______________________________________________________________________________
+void TG4RootNavigator::CreateTGeoNavigator()
+{
+  /// Create the TGeo navigator (with its node cache) for this thread.
+  /// It is called at the first locate, so that no TGeo navigation state
+  /// is allocated for threads which do not track.
+  fNavigator = fGeometry->GetCurrentNavigator();
+  if (!fNavigator) fNavigator = fGeometry->AddNavigator();
+}
+
+//______________________________________________________________________________
+G4double TG4RootNavigator::NudgeStep(const G4ThreeVector& point)
+{
+  /// Return the nudge step length for the stuck track at the given point
+  /// and record the nudge in the registry of stuck tracks per pair of the
+  /// current and the next volume.
+  G4double nudge = fgZeroStepPolicy.fNudge *
+                   std::pow(fgZeroStepPolicy.fNudgeFactor, fNofNudges);
+  if (nudge > fgZeroStepPolicy.fMaxNudge) nudge = fgZeroStepPolicy.fMaxNudge;
+  fNofNudges++;
+  fNzeroSteps = 0;
+
+  TGeoNode* nextNode = fNavigator->GetNextNode();
+  const G4VPhysicalVolume* nextVolume =
+    nextNode ? fDetConstruction->GetG4VPhysicalVolume(nextNode) : 0;
+  StuckEntry& entry =
+    fStuckRegistry[std::make_pair(fHistory.GetTopVolume(), nextVolume)];
+  if (!entry.fNofNudges) entry.fPosition = point;
+  entry.fNofNudges++;
+  if (fNofNudges > entry.fMaxNofNudges) entry.fMaxNofNudges = fNofNudges;
+  return nudge;
+}
+
+//______________________________________________________________________________
+const G4LogicalVolume* TG4RootNavigator::GetSubtreeRoot(Bool_t& native) const
+{
+  /// Return the root volume of the navigation subtree of the current volume:
+  /// the outermost volume in the navigation history selected for navigation
+  /// with G4Navigator (native = true), or the daughter of the world volume
+  /// in the history, navigated by TGeo (native = false).
+  Int_t depth = fHistory.GetDepth();
+  if (fDetConstruction->HasNativeNavigation()) {
+    for (Int_t level = 0; level <= depth; level++) {
+      const G4LogicalVolume* lvol =
+        fHistory.GetVolume(level)->GetLogicalVolume();
+      if (fDetConstruction->IsNativeNavigation(lvol)) {
+        native = kTRUE;
+        return lvol;
+      }
+    }
+  }
+  native = kFALSE;
+  return fHistory.GetVolume(std::min(depth, 1))->GetLogicalVolume();
+}
+
+//______________________________________________________________________________
+G4VPhysicalVolume* TG4RootNavigator::SwitchNavigation(
+  const G4ThreeVector& point, const G4ThreeVector* direction,
+  G4bool ignoreDirection, G4VPhysicalVolume* target)
+{
+  /// Switch the navigation engine if the located volume is navigated
+  /// by the other one and set up its state. Returns the located volume.
+  if (!target) return target;
+  Bool_t nativeMode = kFALSE;
+  const G4LogicalVolume* subtreeRoot = GetSubtreeRoot(nativeMode);
+  if (subtreeRoot != fSubtreeRoot || !fSubtreeTiming) {
+    fSubtreeRoot = subtreeRoot;
+    fSubtreeTiming = &fSubtreeTimings[subtreeRoot];
+    fSubtreeTiming->fNative = nativeMode;
+  }
+  if (nativeMode == fNativeMode) return target;
+
+  fStatistics.fNofSwitches++;
+  fNativeMode = nativeMode;
+  if (fNativeMode) {
+    // The G4Navigator state is not valid after TGeo navigation:
+    // locate the point from the world volume
+    fStatistics.fNofNativeLocates++;
+    return G4Navigator::LocateGlobalPointAndSetup(
+      point, direction, false, ignoreDirection);
+  }
+
+  // Set TGeo to the volume located by G4Navigator; the boundary flags
+  // (fEnteredDaughter, fExitedMother) are kept for the next TGeo step
+  SynchronizeGeoManager();
+  fNavigator->SetCurrentPoint(
+    point.x() * gCm, point.y() * gCm, point.z() * gCm);
+  fStepEntering = kFALSE;
+  fStepExiting = kFALSE;
+  fNextPoint.set(kInfinity, kInfinity, kInfinity);
+  fSafetyOrig.set(kInfinity, kInfinity, kInfinity);
+  fLastSafety = 0.;
+  return target;
 }
 
 //______________________________________________________________________________
@@ -113,12 +362,18 @@ G4double TG4RootNavigator::ComputeStep(const G4ThreeVector& pGlobalPoint,
 
   // The following 2 lines are not needed if G4 calls first LocateGlobalPoint...
   //   fGeometry->ResetState();
-  static Long64_t istep = 0;
-  istep++;
+  fStatistics.fNofSteps++;
+  SubtreeTimer timer(fSubtreeTiming);
+  fNativeStep = fNativeMode;
+  if (fNativeMode) {
+    fStatistics.fNofNativeSteps++;
+    return G4Navigator::ComputeStep(
+      pGlobalPoint, pDirection, pCurrentProposedStepLength, pNewSafety);
+  }
 
 #ifdef G4ROOT_DEBUG
   G4cout.precision(8);
-  G4cout << "*** ComputeStep #" << istep << ": ***"
+  G4cout << "*** ComputeStep #" << fStatistics.fNofSteps << ": ***"
          << fHistory.GetTopVolume()->GetName()
          << " entered: " << fEnteredDaughter << "  exited: " << fExitedMother
          << G4endl;
@@ -156,16 +411,33 @@ G4double TG4RootNavigator::ComputeStep(const G4ThreeVector& pGlobalPoint,
 #endif
       compute_safety = kFALSE;
       pNewSafety = fLastSafety;
+      fStatistics.fNofSafetyHits++;
+    }
+    else if (compute_safety && d2 < fLastSafety * fLastSafety) {
+      // The point is inside the last safety sphere: use the remaining safety
+      compute_safety = kFALSE;
+      pNewSafety = fLastSafety - std::sqrt(d2);
+      fStatistics.fNofSafetySphereHits++;
+    }
+    if (!compute_safety && pCurrentProposedStepLength < pNewSafety) {
+      // No boundary can be reached within the proposed step
+      fStatistics.fNofSafeSteps++;
+      fNzeroSteps = 0;
+      fNofNudges = 0;
+      fStepEntering = kFALSE;
+      fStepExiting = kFALSE;
+      return kInfinity;
     }
-    fSafetyOrig = pGlobalPoint;
   }
   fNavigator->SetCurrentDirection(
     pDirection.x(), pDirection.y(), pDirection.z());
   fNavigator->FindNextBoundary(-(pstep * gCm - tol), "", !compute_safety);
 
   if (compute_safety) {
+    fStatistics.fNofSafeties++;
     pNewSafety = (fNavigator->GetSafeDistance() - tol) * cm;
     if (pNewSafety < 0.) pNewSafety = 0.;
+    fSafetyOrig = pGlobalPoint;
     fLastSafety = pNewSafety;
   }
   G4double step = (fNavigator->GetStep() + tol) * cm;
@@ -173,14 +445,23 @@ G4double TG4RootNavigator::ComputeStep(const G4ThreeVector& pGlobalPoint,
   if (step < 1.e3 * tol * cm) {
     step = 0.;
     fNzeroSteps++;
+    fStatistics.fNofZeroSteps++;
     // Geant4 will abandon the track if the number of zero steps>50 just
     // because it expects a non-zero distance inside the mother to the next
     // daughter The way out is to generate an extra very small fake step in the
-    // mother, before this threshold is reached
-    if (fNzeroSteps > gAbandonZeroSteps) step = gZeroStepThr;
+    // mother, before this threshold is reached. The threshold is lowered
+    // for a track which was already nudged (see ZeroStepPolicy).
+    Int_t maxZeroSteps = (fNofNudges < 31)
+                           ? fgZeroStepPolicy.fMaxZeroSteps >> fNofNudges
+                           : 0;
+    if (fNzeroSteps > std::max(maxZeroSteps, 1)) {
+      step = NudgeStep(pGlobalPoint);
+      fStatistics.fNofForcedSteps++;
+    }
   }
   else {
     fNzeroSteps = 0;
+    fNofNudges = 0;
   }
   fStepEntering = fNavigator->IsStepEntering();
   fStepExiting = fNavigator->IsStepExiting();
@@ -231,17 +512,19 @@ G4VPhysicalVolume* TG4RootNavigator::ResetHierarchyAndLocate(
   G4cout << "ResetHierarchyAndLocate: POINT: " << point << " DIR: " << direction
          << G4endl;
 #endif
+  if (!fNavigator) CreateTGeoNavigator();
   ResetState();
   fEnteredDaughter = kFALSE;
   fExitedMother = kFALSE;
   fStepEntering = kFALSE;
   fStepExiting = kFALSE;
+  fNativeMode = kFALSE;
   fHistory = *h.GetHistory();
   SynchronizeGeoManager();
   fNavigator->InitTrack(point.x() * gCm, point.y() * gCm, point.z() * gCm,
     direction.x(), direction.y(), direction.z());
   G4VPhysicalVolume* pVol = SynchronizeHistory();
-  return pVol;
+  return SwitchNavigation(point, &direction, false, pVol);
 }
 
 //______________________________________________________________________________
@@ -257,7 +540,7 @@ TGeoNode* TG4RootNavigator::SynchronizeGeoManager()
   TGeoNode *pnode, *newnode = 0;
   for (level = 1; level <= depth; level++) {
     pvol = fHistory.GetVolume(level);
-    newnode = fDetConstruction->GetNode(pvol);
+    newnode = GetBranchNode(level, pvol);
     if (level <= geolevel) {
       // TGeo has also something at this level - check if it matches what is
       // in fHistory
@@ -271,7 +554,7 @@ TGeoNode* TG4RootNavigator::SynchronizeGeoManager()
       }
       // Now TGeo is at level-1 and needs to update level
       // this should be the index of the node to be used in CdDown(index)
-      nodeIndex = fNavigator->GetCurrentVolume()->GetIndex(newnode);
+      nodeIndex = GetDaughterIndex(pvol, newnode);
       if (nodeIndex < 0) {
         G4cerr << "SynchronizeGeoManager did not work (1)!!!" << G4endl;
         return NULL;
@@ -282,7 +565,7 @@ TGeoNode* TG4RootNavigator::SynchronizeGeoManager()
     }
     else {
       // This level has to be synchronized
-      nodeIndex = fNavigator->GetCurrentVolume()->GetIndex(newnode);
+      nodeIndex = GetDaughterIndex(pvol, newnode);
       if (nodeIndex < 0) {
         G4cerr << "SynchronizeGeoManager did not work (2)!!!" << G4endl;
         return NULL;
@@ -308,7 +591,7 @@ G4VPhysicalVolume* TG4RootNavigator::SynchronizeHistory()
   Int_t level;
   for (level = 0; level <= geolevel; level++) {
     pnode = fNavigator->GetMother(geolevel - level);
-    pnewvol = fDetConstruction->GetG4VPhysicalVolume(pnode);
+    pnewvol = GetBranchVolume(level, pnode);
     if (level <= depth) {
       pvol = fHistory.GetVolume(level);
       // If the phys. volume at this level matches the one in the history, do
@@ -341,7 +624,7 @@ G4VPhysicalVolume* TG4RootNavigator::SynchronizeHistory()
 //______________________________________________________________________________
 G4VPhysicalVolume* TG4RootNavigator::LocateGlobalPointAndSetup(
   const G4ThreeVector& globalPoint, const G4ThreeVector* pGlobalDirection,
-  const G4bool /*relativeSearch*/, const G4bool ignoreDirection)
+  const G4bool relativeSearch, const G4bool ignoreDirection)
 {
   /// Locate the point in the hierarchy return 0 if outside
   /// The direction is required
@@ -355,8 +638,8 @@ G4VPhysicalVolume* TG4RootNavigator::LocateGlobalPointAndSetup(
   ///                     whether daughter of last mother directly
   ///                     or daughter of that volume's ancestor.
 
-  static Long64_t ilocate = 0;
-  ilocate++;
+  fStatistics.fNofLocates++;
+  if (!fNavigator) CreateTGeoNavigator();
 
   // Flag if geometry state was recovered.
   Bool_t isGeoStateRestored = kFALSE;
@@ -366,11 +649,22 @@ G4VPhysicalVolume* TG4RootNavigator::LocateGlobalPointAndSetup(
       fG4TrackingManager->GetTrack()->GetParentID() == 0) {
     Int_t currG4TrackId = fG4TrackingManager->GetTrack()->GetTrackID();
     isGeoStateRestored = fRestoreGeoStateFunction(currG4TrackId);
+    if (isGeoStateRestored) fStatistics.fNofStateRestores++;
   }
 
+  if (fNativeMode && !isGeoStateRestored) {
+    fStatistics.fNofNativeLocates++;
+    G4VPhysicalVolume* target = G4Navigator::LocateGlobalPointAndSetup(
+      globalPoint, pGlobalDirection, relativeSearch, ignoreDirection);
+    return SwitchNavigation(
+      globalPoint, pGlobalDirection, ignoreDirection, target);
+  }
+  // The restored geometry state is the TGeo one
+  fNativeMode = kFALSE;
+
 #ifdef G4ROOT_DEBUG
   G4cout.precision(12);
-  G4cout << "LocateGlobalPointAndSetup #" << ilocate
+  G4cout << "LocateGlobalPointAndSetup #" << fStatistics.fNofLocates
          << ": point: " << globalPoint << G4endl;
 #endif
   fNavigator->SetCurrentPoint(
@@ -414,6 +708,7 @@ G4VPhysicalVolume* TG4RootNavigator::LocateGlobalPointAndSetup(
     }
     fNavigator->CdNext();
     fNavigator->CrossBoundaryAndLocate(fStepEntering, skip);
+    fStatistics.fNofRelocations++;
   }
   else if (!isGeoStateRestored) {
     //      if (!relativeSearch) fNavigator->CdTop();
@@ -426,7 +721,8 @@ G4VPhysicalVolume* TG4RootNavigator::LocateGlobalPointAndSetup(
            << " entered=" << fEnteredDaughter << " exited=" << fExitedMother
            << G4endl;
 #endif
-  return target;
+  return SwitchNavigation(
+    globalPoint, pGlobalDirection, ignoreDirection, target);
 }
 
 //______________________________________________________________________________
@@ -447,6 +743,10 @@ void TG4RootNavigator::LocateGlobalPointWithinVolume(
   G4cout.precision(12);
   G4cout << "LocateGlobalPointWithinVolume " << pGlobalPoint << G4endl;
 #endif
+  if (fNativeMode) {
+    G4Navigator::LocateGlobalPointWithinVolume(pGlobalPoint);
+    return;
+  }
   fNavigator->SetCurrentPoint(
     pGlobalPoint.x() * gCm, pGlobalPoint.y() * gCm, pGlobalPoint.z() * gCm);
   fStepEntering = kFALSE;
@@ -466,7 +766,7 @@ G4double TG4RootNavigator::ComputeSafety(const G4ThreeVector& globalpoint,
 
 //______________________________________________________________________________
 G4double TG4RootNavigator::ComputeSafety(
-  const G4ThreeVector& globalpoint, const G4double /*pProposedMaxLength*/)
+  const G4ThreeVector& globalpoint, const G4double pProposedMaxLength)
 {
   /// Calculate the isotropic distance to the nearest boundary from the
   /// specified point in the global coordinate system.
@@ -480,6 +780,9 @@ G4double TG4RootNavigator::ComputeSafety(
   ///   fExitedMother = kFALSE;
   ///   fStepEntering = kFALSE;
   ///   fStepExiting = kFALSE;
+  if (fNativeMode) {
+    return G4Navigator::ComputeSafety(globalpoint, pProposedMaxLength);
+  }
   Double_t d2 = globalpoint.diff2(fNextPoint);
   if (d2 < 1.e-10) {
 #ifdef G4ROOT_DEBUG
@@ -494,12 +797,24 @@ G4double TG4RootNavigator::ComputeSafety(
     G4cout << "ComputeSafety: POINT not changed: " << globalpoint
            << " SKIPPED... oldsafe=" << fLastSafety << G4endl;
 #endif
+    fStatistics.fNofSafetyHits++;
     return fLastSafety;
   }
+  if (d2 < fLastSafety * fLastSafety) {
+    // The point is inside the last safety sphere: return the remaining safety
+    G4double safety = fLastSafety - std::sqrt(d2);
+#ifdef G4ROOT_DEBUG
+    G4cout << "ComputeSafety: POINT inside safety sphere: " << globalpoint
+           << " SKIPPED... safe=" << safety << G4endl;
+#endif
+    fStatistics.fNofSafetySphereHits++;
+    return safety;
+  }
   fNavigator->ResetState();
   fNavigator->SetCurrentPoint(
     globalpoint.x() * gCm, globalpoint.y() * gCm, globalpoint.z() * gCm);
   G4double safety = fNavigator->Safety() * cm;
+  fStatistics.fNofSafeties++;
   fSafetyOrig = globalpoint;
   fLastSafety = safety;
 
@@ -529,6 +844,7 @@ G4ThreeVector TG4RootNavigator::GetLocalExitNormal(G4bool* valid)
   /// (The normal is in the coordinate system of the final volume.)
   /// This function takes full care about how to calculate this normal,
   /// but if the surfaces are not convex it will return valid=false.
+  if (fNativeStep) return G4Navigator::GetLocalExitNormal(valid);
   Double_t *norm, lnorm[3];
   *valid = true;
   norm = fNavigator->FindNormalFast();
@@ -549,7 +865,7 @@ G4ThreeVector TG4RootNavigator::GetLocalExitNormal(G4bool* valid)
 
 //______________________________________________________________________________
 G4ThreeVector TG4RootNavigator::GetGlobalExitNormal(
-  const G4ThreeVector& /*point*/, G4bool* valid)
+  const G4ThreeVector& point, G4bool* valid)
 {
   // Return Exit Surface Normal and validity too.
   // Can only be called if the Navigator's last Step has crossed a
@@ -562,6 +878,7 @@ G4ThreeVector TG4RootNavigator::GetGlobalExitNormal(
   //   Normals are not available for replica volumes (returns valid= false)
   // These methods takes full care about how to calculate this normal,
   // but if the surfaces are not convex it will return valid=false.
+  if (fNativeStep) return G4Navigator::GetGlobalExitNormal(point, valid);
   Double_t* norm;
   *valid = true;
   norm = fNavigator->FindNormalFast();
@@ -591,3 +908,179 @@ void TG4RootNavigator::SetGeometryRestoreFunction(
 {
   fRestoreGeoStateFunction = restoreGeoStateFunction;
 }
+
+//______________________________________________________________________________
+void TG4RootNavigator::SetZeroStepPolicy(const ZeroStepPolicy& policy)
+{
+  /// Set the zero step policy. It is shared by all threads and read without
+  /// locking, so it must be set before the worker threads are started
+  /// (the UI command is available only in PreInit).
+  fgZeroStepPolicy = policy;
+}
+
+//______________________________________________________________________________
+void TG4RootNavigator::MergeStatistics()
+{
+  /// Add the navigation statistics of this thread to the merged statistics
+  /// and clear them. Called at the end of run on workers (or in sequential
+  /// mode).
+  if (fStatistics.fNofLocates) {
+    fStatistics.fNofTrackingThreads = 1;
+    fStatistics.fMemory = GetMemoryUsage();
+  }
+#ifdef G4MULTITHREADED
+  G4AutoLock lm(&mergeStatisticsMutex);
+#endif
+  fgMergedStatistics.Add(fStatistics);
+  if (fDetConstruction) fgSharedMemory = fDetConstruction->GetMemoryUsage();
+  for (const auto& it : fStuckRegistry) {
+    StuckEntry& entry = fgMergedStuckRegistry[std::make_pair(
+      GetVolumeName(it.first.first), GetVolumeName(it.first.second))];
+    if (!entry.fNofNudges) entry.fPosition = it.second.fPosition;
+    entry.fNofNudges += it.second.fNofNudges;
+    entry.fMaxNofNudges =
+      std::max(entry.fMaxNofNudges, it.second.fMaxNofNudges);
+  }
+  fStuckRegistry.clear();
+  for (const auto& it : fSubtreeTimings) {
+    SubtreeTiming& timing = fgMergedSubtreeTimings[it.first->GetName()];
+    timing.fNofSteps += it.second.fNofSteps;
+    timing.fTime += it.second.fTime;
+    timing.fNative = it.second.fNative;
+  }
+  fSubtreeTimings.clear();
+  fSubtreeRoot = 0;
+  fSubtreeTiming = 0;
+  ClearStatistics();
+}
+
+//______________________________________________________________________________
+Long64_t TG4RootNavigator::GetMemoryUsage() const
+{
+  /// Return the estimated memory (in bytes) of the navigation state of this
+  /// thread: this navigator with its navigation history and branch mirror
+  /// and the TGeo navigator with its node cache (if created).
+  /// The lookup tables of the detector construction are shared by all
+  /// threads and are not included.
+  size_t memory = sizeof(TG4RootNavigator) +
+                  fHistory.GetMaxDepth() * (sizeof(G4NavigationLevel) +
+                                             sizeof(G4NavigationLevelRep)) +
+                  fBranchNodes.capacity() * sizeof(TGeoNode*) +
+                  fBranchVolumes.capacity() * sizeof(G4VPhysicalVolume*);
+  if (fNavigator) {
+    // The node cache keeps per level the node, its global matrix and state
+    // info, and a stack of cache states of the same depth
+    size_t nofLevels = fGeometry->GetMaxLevel() + 1;
+    memory += sizeof(TGeoNavigator) + sizeof(TGeoNodeCache) +
+              (1 + gCacheStackSize) * nofLevels *
+                (sizeof(TGeoHMatrix) + 4 * sizeof(void*));
+  }
+  return memory;
+}
+
+//______________________________________________________________________________
+void TG4RootNavigator::PrintStatistics()
+{
+  /// Print the navigation statistics merged from all threads and clear them.
+  /// Called at the end of run on master (or in sequential mode).
+  const Statistics& stat = fgMergedStatistics;
+  if (!stat.fNofSteps && !stat.fNofLocates) return;
+
+  Long64_t nofSafetyRequests =
+    stat.fNofSafeties + stat.fNofSafetyHits + stat.fNofSafetySphereHits;
+  Double_t safetyHitRate =
+    nofSafetyRequests ? Double_t(stat.fNofSafetyHits) / nofSafetyRequests : 0.;
+  Double_t sphereHitRate =
+    nofSafetyRequests ? Double_t(stat.fNofSafetySphereHits) / nofSafetyRequests
+                      : 0.;
+  Double_t safeStepRate =
+    stat.fNofSteps ? Double_t(stat.fNofSafeSteps) / stat.fNofSteps : 0.;
+  Double_t zeroStepRate =
+    stat.fNofSteps ? Double_t(stat.fNofZeroSteps) / stat.fNofSteps : 0.;
+  Double_t nativeStepRate =
+    stat.fNofSteps ? Double_t(stat.fNofNativeSteps) / stat.fNofSteps : 0.;
+
+  G4cout << "TG4RootNavigator statistics (merged from all threads): " << G4endl
+         << "   Number of steps:         " << stat.fNofSteps << G4endl
+         << "   Number of zero steps:    " << stat.fNofZeroSteps << " ("
+         << zeroStepRate * 100. << " %)" << G4endl
+         << "   Number of forced steps:  " << stat.fNofForcedSteps << G4endl
+         << "   Number of locates:       " << stat.fNofLocates << G4endl
+         << "   Number of relocations:   " << stat.fNofRelocations << G4endl
+         << "   Number of safeties:      " << stat.fNofSafeties << G4endl
+         << "   Number of safety hits:   " << stat.fNofSafetyHits << " ("
+         << safetyHitRate * 100. << " %)" << G4endl
+         << "   Number of sphere hits:   " << stat.fNofSafetySphereHits << " ("
+         << sphereHitRate * 100. << " %)" << G4endl
+         << "   Number of safe steps:    " << stat.fNofSafeSteps << " ("
+         << safeStepRate * 100. << " %)" << G4endl
+         << "   Number of restores:      " << stat.fNofStateRestores << G4endl;
+  if (stat.fNofTrackingThreads) {
+    G4cout << "   Tracking threads:        " << stat.fNofTrackingThreads
+           << G4endl
+           << "   Memory per thread:       "
+           << stat.fMemory / stat.fNofTrackingThreads / 1024. << " kB"
+           << G4endl
+           << "   Shared tables memory:    " << fgSharedMemory / 1024. << " kB"
+           << G4endl;
+  }
+
+  if (stat.fNofNativeSteps || stat.fNofSwitches) {
+    G4cout << "   Number of G4 steps:      " << stat.fNofNativeSteps << " ("
+           << nativeStepRate * 100. << " %)" << G4endl
+           << "   Number of G4 locates:    " << stat.fNofNativeLocates << G4endl
+           << "   Number of switches:      " << stat.fNofSwitches << G4endl;
+  }
+
+  if (fgMergedStuckRegistry.size()) {
+    // Print the volume pairs with the most nudges
+    std::vector<std::pair<std::pair<G4String, G4String>, StuckEntry>> entries(
+      fgMergedStuckRegistry.begin(), fgMergedStuckRegistry.end());
+    std::sort(entries.begin(), entries.end(),
+      [](const std::pair<std::pair<G4String, G4String>, StuckEntry>& a,
+        const std::pair<std::pair<G4String, G4String>, StuckEntry>& b) {
+        return a.second.fNofNudges > b.second.fNofNudges;
+      });
+    G4cout << "   Stuck tracks (top " << gMaxNofStuckEntries << " of "
+           << entries.size() << " volume pairs):" << G4endl
+           << "      volume -> next volume: nudges, max consecutive nudges, "
+           << "first position [mm]" << G4endl;
+    G4int counter = 0;
+    for (const auto& entry : entries) {
+      if (counter++ == gMaxNofStuckEntries) break;
+      G4cout << "      " << entry.first.first << " -> " << entry.first.second
+             << ": " << entry.second.fNofNudges << ", "
+             << entry.second.fMaxNofNudges << ", " << entry.second.fPosition
+             << G4endl;
+    }
+    fgMergedStuckRegistry.clear();
+  }
+
+  if (fgMergedSubtreeTimings.size()) {
+    // Print the navigation subtrees with the most time
+    std::vector<std::pair<G4String, SubtreeTiming>> entries(
+      fgMergedSubtreeTimings.begin(), fgMergedSubtreeTimings.end());
+    std::sort(entries.begin(), entries.end(),
+      [](const std::pair<G4String, SubtreeTiming>& a,
+        const std::pair<G4String, SubtreeTiming>& b) {
+        return a.second.fTime > b.second.fTime;
+      });
+    G4cout << "   Step time per subtree (top " << gMaxNofSubtreeEntries
+           << " of " << entries.size() << " subtrees):" << G4endl
+           << "      root volume: navigator, steps, time [s], "
+           << "time per step [us]" << G4endl;
+    G4int counter = 0;
+    for (const auto& entry : entries) {
+      if (counter++ == gMaxNofSubtreeEntries) break;
+      const SubtreeTiming& timing = entry.second;
+      G4cout << "      " << entry.first << ": "
+             << (timing.fNative ? "G4Navigator" : "TGeo") << ", "
+             << timing.fNofSteps << ", " << timing.fTime << ", "
+             << (timing.fNofSteps ? timing.fTime / timing.fNofSteps * 1.e6 : 0.)
+             << G4endl;
+    }
+    fgMergedSubtreeTimings.clear();
+  }
+
+  fgMergedStatistics = Statistics();
+}
@@ -26,40 +26,451 @@
 #include "G4NURBS.hh"
 #include "G4NURBSbox.hh"
 #endif
+#if G4VERSION_NUMBER >= 1030
+#include "G4BoundingEnvelope.hh"
+#endif
 // #include "G4SystemOfUnits.hh"
 #include "G4VisExtent.hh"
 
 #include "TGeoBBox.h"
 #include "TGeoShape.h"
+#include "TGeoTrd1.h"
+#include "TGeoTrd2.h"
+#include "TGeoTube.h"
 #include "TMath.h"
 
 // Moved after ROOT includes to avoid warnings about shadowing variables
 // from CLHEP units
+#include <G4PhysicalConstants.hh>
 #include <G4SystemOfUnits.hh>
 
+#include <algorithm>
+#include <cmath>
+
 // ClassImp(TG4RootSolid)
 
 /// constant for conversion cm <-> mm
 static const Double_t gCm = 1. / cm;
 
+namespace
+{
+/// Distance from the point at radius r to the half-plane at the angle a
+/// (0 <= a <= 2*pi) from the point direction
+inline G4double HalfPlaneDistance(G4double a, G4double r)
+{
+  return (a < halfpi) ? r * std::sin(a) : r;
+}
+} // namespace
+
 //______________________________________________________________________________
-TG4RootSolid::TG4RootSolid(TGeoShape* shape) : G4VSolid(shape->GetName())
+TG4RootSolid::TG4RootSolid()
+  : G4VSolid(""),
+    fShape(0),
+    fShapeType(kGeneric),
+    fNofPlanes(0),
+    fRmin(0.),
+    fRmax(0.),
+    fDz(0.),
+    fPhi1(0.),
+    fDphi(0.),
+    fBoxMin(),
+    fBoxMax(),
+    fCubicVolume(-1.)
+{
+  /// Default constructor.
+}
+
+//______________________________________________________________________________
+TG4RootSolid::TG4RootSolid(TGeoShape* shape)
+  : G4VSolid(shape->GetName()),
+    fShape(shape),
+    fShapeType(kGeneric),
+    fNofPlanes(0),
+    fRmin(0.),
+    fRmax(0.),
+    fDz(0.),
+    fPhi1(0.),
+    fDphi(0.),
+    fBoxMin(),
+    fBoxMax(),
+    fCubicVolume(-1.)
 {
   /// Constructor.
-  fShape = shape;
+  InitShapeType();
+}
+
+//______________________________________________________________________________
+void TG4RootSolid::InitShapeType()
+{
+  /// Select the specialised implementation by the exact shape class
+  /// and convert the shape parameters in G4 units.
+  /// The derived TGeo classes (eg. TGeoCtub from TGeoTubeSeg) keep
+  /// the generic implementation.
+
+  TGeoBBox* bbox = (TGeoBBox*)fShape;
+  const Double_t* origin = bbox->GetOrigin();
+  G4ThreeVector halfLengths(
+    bbox->GetDX() * cm, bbox->GetDY() * cm, bbox->GetDZ() * cm);
+  G4ThreeVector center(origin[0] * cm, origin[1] * cm, origin[2] * cm);
+  fBoxMin = center - halfLengths;
+  fBoxMax = center + halfLengths;
+
+  TClass* shapeClass = fShape->IsA();
+  if (shapeClass == TGeoBBox::Class()) {
+    fShapeType = kConvex;
+    AddPlane(1., 0., 0., -fBoxMax.x());
+    AddPlane(-1., 0., 0., fBoxMin.x());
+    AddPlane(0., 1., 0., -fBoxMax.y());
+    AddPlane(0., -1., 0., fBoxMin.y());
+    AddPlane(0., 0., 1., -fBoxMax.z());
+    AddPlane(0., 0., -1., fBoxMin.z());
+  }
+  else if (shapeClass == TGeoTrd1::Class() || shapeClass == TGeoTrd2::Class()) {
+    G4double dx1, dx2, dy1, dy2, dz;
+    if (shapeClass == TGeoTrd1::Class()) {
+      TGeoTrd1* trd = (TGeoTrd1*)fShape;
+      dx1 = trd->GetDx1() * cm;
+      dx2 = trd->GetDx2() * cm;
+      dy1 = trd->GetDy() * cm;
+      dy2 = dy1;
+      dz = trd->GetDz() * cm;
+    }
+    else {
+      TGeoTrd2* trd = (TGeoTrd2*)fShape;
+      dx1 = trd->GetDx1() * cm;
+      dx2 = trd->GetDx2() * cm;
+      dy1 = trd->GetDy1() * cm;
+      dy2 = trd->GetDy2() * cm;
+      dz = trd->GetDz() * cm;
+    }
+    if (dz <= 0.) return;
+
+    // The side planes x = +-(hx + kx*z), y = +-(hy + ky*z)
+    G4double kx = 0.5 * (dx2 - dx1) / dz;
+    G4double hx = 0.5 * (dx1 + dx2);
+    G4double ky = 0.5 * (dy2 - dy1) / dz;
+    G4double hy = 0.5 * (dy1 + dy2);
+    G4double nx = 1. / std::sqrt(1. + kx * kx);
+    G4double ny = 1. / std::sqrt(1. + ky * ky);
+
+    fShapeType = kConvex;
+    AddPlane(nx, 0., -kx * nx, -hx * nx);
+    AddPlane(-nx, 0., -kx * nx, -hx * nx);
+    AddPlane(0., ny, -ky * ny, -hy * ny);
+    AddPlane(0., -ny, -ky * ny, -hy * ny);
+    AddPlane(0., 0., 1., -dz);
+    AddPlane(0., 0., -1., -dz);
+  }
+  else if (shapeClass == TGeoTube::Class() ||
+           shapeClass == TGeoTubeSeg::Class()) {
+    TGeoTube* tube = (TGeoTube*)fShape;
+    fRmin = tube->GetRmin() * cm;
+    fRmax = tube->GetRmax() * cm;
+    fDz = tube->GetDz() * cm;
+    fShapeType = kTube;
+
+    if (shapeClass == TGeoTubeSeg::Class()) {
+      TGeoTubeSeg* tubeSeg = (TGeoTubeSeg*)fShape;
+      fPhi1 = tubeSeg->GetPhi1() * deg;
+      fDphi = (tubeSeg->GetPhi2() - tubeSeg->GetPhi1()) * deg;
+      if (fDphi < twopi - kAngTolerance) fShapeType = kTubeSeg;
+    }
+  }
+}
+
+//______________________________________________________________________________
+void TG4RootSolid::AddPlane(G4double a, G4double b, G4double c, G4double d)
+{
+  /// Add the plane a*x+b*y+c*z+d = 0 to the convex polyhedron planes.
+
+  fPlanes[fNofPlanes][0] = a;
+  fPlanes[fNofPlanes][1] = b;
+  fPlanes[fNofPlanes][2] = c;
+  fPlanes[fNofPlanes][3] = d;
+  ++fNofPlanes;
+}
+
+//______________________________________________________________________________
+G4double TG4RootSolid::ConvexDistance(const G4ThreeVector& p) const
+{
+  /// Return the maximum signed distance of the point from the planes
+  /// (negative inside).
+
+  G4double dist = -kInfinity;
+  for (G4int i = 0; i < fNofPlanes; ++i) {
+    const G4double* plane = fPlanes[i];
+    G4double d =
+      plane[0] * p.x() + plane[1] * p.y() + plane[2] * p.z() + plane[3];
+    if (d > dist) dist = d;
+  }
+  return dist;
+}
+
+//______________________________________________________________________________
+G4double TG4RootSolid::ConvexDistanceToIn(
+  const G4ThreeVector& p, const G4ThreeVector& v) const
+{
+  /// Return the distance along v to the convex polyhedron by clipping
+  /// the ray with the planes.
+
+  G4double halfTolerance = 0.5 * kCarTolerance;
+  G4double tmin = -kInfinity;
+  G4double tmax = kInfinity;
+  for (G4int i = 0; i < fNofPlanes; ++i) {
+    const G4double* plane = fPlanes[i];
+    G4double cosa = plane[0] * v.x() + plane[1] * v.y() + plane[2] * v.z();
+    G4double dist =
+      plane[0] * p.x() + plane[1] * p.y() + plane[2] * p.z() + plane[3];
+    if (dist >= -halfTolerance) {
+      // outside this plane (or on it)
+      if (cosa >= 0.) return kInfinity;
+      G4double t = -dist / cosa;
+      if (t > tmin) tmin = t;
+    }
+    else if (cosa > 0.) {
+      G4double t = -dist / cosa;
+      if (t < tmax) tmax = t;
+    }
+  }
+  if (tmax <= tmin + halfTolerance) return kInfinity;
+  return (tmin < halfTolerance) ? 0. : tmin;
+}
+
+//______________________________________________________________________________
+G4double TG4RootSolid::ConvexDistanceToOut(const G4ThreeVector& p,
+  const G4ThreeVector& v, const G4bool calcNorm, G4bool* validNorm,
+  G4ThreeVector* n) const
+{
+  /// Return the distance along v to exit the convex polyhedron;
+  /// the normal of the exiting plane is always valid.
+
+  G4double halfTolerance = 0.5 * kCarTolerance;
+  G4double tmax = kInfinity;
+  G4int iplane = 0;
+  for (G4int i = 0; i < fNofPlanes; ++i) {
+    const G4double* plane = fPlanes[i];
+    G4double cosa = plane[0] * v.x() + plane[1] * v.y() + plane[2] * v.z();
+    if (cosa <= 0.) continue;
+    G4double dist =
+      plane[0] * p.x() + plane[1] * p.y() + plane[2] * p.z() + plane[3];
+    if (dist >= -halfTolerance) {
+      // on the surface and moving out
+      tmax = 0.;
+      iplane = i;
+      break;
+    }
+    G4double t = -dist / cosa;
+    if (t < tmax) {
+      tmax = t;
+      iplane = i;
+    }
+  }
+  if (calcNorm) {
+    *validNorm = true;
+    *n = G4ThreeVector(
+      fPlanes[iplane][0], fPlanes[iplane][1], fPlanes[iplane][2]);
+  }
+  return tmax;
 }
 
 //______________________________________________________________________________
-G4bool TG4RootSolid::CalculateExtent(const EAxis /*pAxis*/,
-  const G4VoxelLimits& /*pVoxelLimit*/, const G4AffineTransform& /*pTransform*/,
-  G4double& /*pMin*/, G4double& /*pMax*/) const
+G4double TG4RootSolid::TubeDistance(const G4ThreeVector& p) const
+{
+  /// Return the signed distance estimate of the point from the tube
+  /// (segment) surfaces (negative inside).
+
+  G4double r = std::sqrt(p.x() * p.x() + p.y() * p.y());
+  G4double dist = std::max(std::abs(p.z()) - fDz, r - fRmax);
+  if (fRmin > 0.) dist = std::max(dist, fRmin - r);
+
+  if (fShapeType == kTubeSeg) {
+    // the points on the axis are on both phi planes (the surface)
+    G4double distPhi = 0.;
+    if (r > 0.5 * kCarTolerance) {
+      G4double phi = std::fmod(std::atan2(p.y(), p.x()) - fPhi1, twopi);
+      if (phi < 0.) phi += twopi;
+      if (phi <= fDphi) {
+        distPhi = -std::min(
+          HalfPlaneDistance(phi, r), HalfPlaneDistance(fDphi - phi, r));
+      }
+      else {
+        distPhi = std::min(HalfPlaneDistance(twopi - phi, r),
+          HalfPlaneDistance(phi - fDphi, r));
+      }
+    }
+    dist = std::max(dist, distPhi);
+  }
+  return dist;
+}
+
+//______________________________________________________________________________
+G4double TG4RootSolid::TubeDistanceToIn(
+  const G4ThreeVector& p, const G4ThreeVector& v) const
+{
+  /// Return the distance along v to the full tube.
+
+  G4double halfTolerance = 0.5 * kCarTolerance;
+  G4double rmax2 = (fRmax + halfTolerance) * (fRmax + halfTolerance);
+  G4double rmin2 = (fRmin > halfTolerance)
+                     ? (fRmin - halfTolerance) * (fRmin - halfTolerance)
+                     : 0.;
+
+  // entering via the z planes
+  if (std::abs(p.z()) >= fDz - halfTolerance && p.z() * v.z() < 0.) {
+    G4double t = std::max((std::abs(p.z()) - fDz) / std::abs(v.z()), 0.);
+    G4double x = p.x() + t * v.x();
+    G4double y = p.y() + t * v.y();
+    G4double r2 = x * x + y * y;
+    if (r2 <= rmax2 && r2 >= rmin2) return (t < halfTolerance) ? 0. : t;
+  }
+
+  G4double a = v.x() * v.x() + v.y() * v.y();
+  if (a <= 0.) return kInfinity;
+  G4double b = p.x() * v.x() + p.y() * v.y();
+  G4double r2 = p.x() * p.x() + p.y() * p.y();
+
+  // entering via the outer radius
+  G4double c = r2 - fRmax * fRmax;
+  if (c > -2. * fRmax * halfTolerance) {
+    if (b >= 0.) return kInfinity;
+    G4double disc = b * b - a * c;
+    if (disc < 0.) return kInfinity;
+    G4double t = (c > 0.) ? c / (-b + std::sqrt(disc)) : 0.;
+    if (std::abs(p.z() + t * v.z()) <= fDz + halfTolerance)
+      return (t < halfTolerance) ? 0. : t;
+  }
+
+  // entering via the inner radius when leaving the hole
+  // (the ray may reach the hole over the z planes)
+  if (fRmin > 0.) {
+    c = r2 - fRmin * fRmin;
+    G4double t = 0.;
+    if (std::abs(c) >= 2. * fRmin * halfTolerance || b <= 0.) {
+      G4double disc = b * b - a * c;
+      if (disc < 0.) return kInfinity;
+      t = (-b + std::sqrt(disc)) / a;
+      if (t < 0.) return kInfinity;
+    }
+    if (std::abs(p.z() + t * v.z()) <= fDz + halfTolerance)
+      return (t < halfTolerance) ? 0. : t;
+  }
+  return kInfinity;
+}
+
+//______________________________________________________________________________
+G4double TG4RootSolid::TubeDistanceToOut(const G4ThreeVector& p,
+  const G4ThreeVector& v, const G4bool calcNorm, G4bool* validNorm,
+  G4ThreeVector* n) const
+{
+  /// Return the distance along v to exit the full tube;
+  /// the normal is not valid when exiting via the inner radius.
+
+  enum ESide
+  {
+    kZ,
+    kRmax,
+    kRmin
+  };
+
+  G4double halfTolerance = 0.5 * kCarTolerance;
+  G4double tmax = kInfinity;
+  ESide side = kZ;
+
+  // the z planes
+  if (v.z() != 0.) {
+    G4double zEnd = (v.z() > 0.) ? fDz : -fDz;
+    tmax = std::max((zEnd - p.z()) / v.z(), 0.);
+  }
+
+  G4double a = v.x() * v.x() + v.y() * v.y();
+  if (a > 0.) {
+    G4double b = p.x() * v.x() + p.y() * v.y();
+    G4double r2 = p.x() * p.x() + p.y() * p.y();
+
+    // the outer radius
+    G4double c = r2 - fRmax * fRmax;
+    if (c >= -2. * fRmax * halfTolerance && b > 0.) {
+      tmax = 0.;
+      side = kRmax;
+    }
+    else {
+      G4double disc = b * b - a * c;
+      G4double t = (disc > 0.) ? (-b + std::sqrt(disc)) / a : 0.;
+      if (t < tmax) {
+        tmax = t;
+        side = kRmax;
+      }
+    }
+
+    // the inner radius
+    if (fRmin > 0. && b < 0. && tmax > 0.) {
+      c = r2 - fRmin * fRmin;
+      G4double t = 0.;
+      if (c > 2. * fRmin * halfTolerance) {
+        G4double disc = b * b - a * c;
+        t = (disc > 0.) ? c / (-b + std::sqrt(disc)) : kInfinity;
+      }
+      if (t < tmax) {
+        tmax = t;
+        side = kRmin;
+      }
+    }
+  }
+
+  if (tmax < halfTolerance) tmax = 0.;
+
+  if (calcNorm) {
+    G4ThreeVector q = p + tmax * v;
+    switch (side) {
+      case kZ:
+        *n = G4ThreeVector(0., 0., (v.z() > 0.) ? 1. : -1.);
+        *validNorm = true;
+        break;
+      case kRmax:
+        *n = G4ThreeVector(q.x() / fRmax, q.y() / fRmax, 0.);
+        *validNorm = true;
+        break;
+      case kRmin:
+        *n = G4ThreeVector(-q.x() / fRmin, -q.y() / fRmin, 0.);
+        *validNorm = false;
+        break;
+    }
+  }
+  return tmax;
+}
+
+#if G4VERSION_NUMBER >= 1030
+//______________________________________________________________________________
+void TG4RootSolid::BoundingLimits(G4ThreeVector& pMin, G4ThreeVector& pMax) const
+{
+  /// Return the bounding box limits of the TGeo shape.
+  pMin = fBoxMin;
+  pMax = fBoxMax;
+}
+#endif
+
+//______________________________________________________________________________
+G4bool TG4RootSolid::CalculateExtent(const EAxis pAxis,
+  const G4VoxelLimits& pVoxelLimit, const G4AffineTransform& pTransform,
+  G4double& pMin, G4double& pMax) const
 {
   /// Calculate the minimum and maximum extent of the solid, when under the
   /// specified transform, and within the specified limits. If the solid
   /// is not intersected by the region, return false, else return true.
+  /// The extent is computed from the bounding box of the TGeo shape.
+#if G4VERSION_NUMBER >= 1030
+  G4BoundingEnvelope bbox(fBoxMin, fBoxMax);
+  return bbox.CalculateExtent(pAxis, pVoxelLimit, pTransform, pMin, pMax);
+#else
+  (void)pAxis;
+  (void)pVoxelLimit;
+  (void)pTransform;
+  (void)pMin;
+  (void)pMax;
   G4cout << "Warning: TG4RootSolid::CalculateExtent() not implemented"
          << G4endl;
   return false;
+#endif
 }
 
 //______________________________________________________________________________
@@ -68,6 +479,14 @@ EInside TG4RootSolid::Inside(const G4ThreeVector& p) const
   /// Returns kOutside if the point at offset p is outside the shapes
   /// boundaries plus Tolerance/2, kSurface if the point is <= Tolerance/2
   /// from a surface, otherwise kInside.
+  if (fShapeType != kGeneric) {
+    G4double dist =
+      (fShapeType == kConvex) ? ConvexDistance(p) : TubeDistance(p);
+    if (dist > 0.5 * kCarTolerance) return kOutside;
+    if (dist > -0.5 * kCarTolerance) return kSurface;
+    return kInside;
+  }
+
   Double_t pt[3];
   pt[0] = p.x() * gCm;
   pt[1] = p.y() * gCm;
@@ -114,6 +533,9 @@ G4double TG4RootSolid::DistanceToIn(
   /// kInfinity. The first intersection resulting from `leaving' a
   /// surface/volume is discarded. Hence, it is tolerant of points on
   /// the surface of the shape.
+  if (fShapeType == kConvex) return ConvexDistanceToIn(p, v);
+  if (fShapeType == kTube) return TubeDistanceToIn(p, v);
+
   Double_t pt[3], dir[3];
   pt[0] = p.x() * gCm;
   pt[1] = p.y() * gCm;
@@ -131,6 +553,9 @@ G4double TG4RootSolid::DistanceToIn(const G4ThreeVector& p) const
 {
   /// Calculate the distance to the nearest surface of a shape from an
   /// outside point. The distance can be an underestimate.
+  if (fShapeType == kConvex) return std::max(ConvexDistance(p), 0.);
+  if (fShapeType != kGeneric) return std::max(TubeDistance(p), 0.);
+
   Double_t pt[3];
   pt[0] = p.x() * gCm;
   pt[1] = p.y() * gCm;
@@ -159,6 +584,11 @@ G4double TG4RootSolid::DistanceToOut(const G4ThreeVector& p,
   ///
   /// Must be called as solid.DistanceToOut(p,v) or by specifying all
   /// the parameters.
+  if (fShapeType == kConvex)
+    return ConvexDistanceToOut(p, v, calcNorm, validNorm, n);
+  if (fShapeType == kTube)
+    return TubeDistanceToOut(p, v, calcNorm, validNorm, n);
+
   Double_t pt[3], dir[3], norm[3];
   pt[0] = p.x() * gCm;
   pt[1] = p.y() * gCm;
@@ -187,6 +617,9 @@ G4double TG4RootSolid::DistanceToOut(const G4ThreeVector& p) const
 {
   /// Calculate the distance to the nearest surface of a shape from an
   /// inside point. The distance can be an underestimate.
+  if (fShapeType == kConvex) return std::max(-ConvexDistance(p), 0.);
+  if (fShapeType != kGeneric) return std::max(-TubeDistance(p), 0.);
+
   Double_t pt[3];
   pt[0] = p.x() * gCm;
   pt[1] = p.y() * gCm;
@@ -208,13 +641,20 @@ void TG4RootSolid::ComputeDimensions(G4VPVParameterisation* /*p*/,
 //______________________________________________________________________________
 G4double TG4RootSolid::GetCubicVolume()
 {
-  /// Returns an estimation of the solid volume in internal units.
-  /// This method may be overloaded by derived classes to compute the
-  /// exact geometrical quantity for solids where this is possible,
-  /// or anyway to cache the computed value.
-  /// Note: the computed value is NOT cached.
-  G4double capacity = fShape->Capacity() * cm3;
-  return capacity;
+  /// Returns the solid volume in internal units.
+  /// The volume is computed analytically for tubes and by the TGeo shape
+  /// otherwise (TGeo may estimate it by sampling for composite shapes);
+  /// the computed value is cached.
+  if (fCubicVolume < 0.) {
+    if (fShapeType == kTube || fShapeType == kTubeSeg) {
+      G4double dphi = (fShapeType == kTubeSeg) ? fDphi : twopi;
+      fCubicVolume = dphi * (fRmax * fRmax - fRmin * fRmin) * fDz;
+    }
+    else {
+      fCubicVolume = fShape->Capacity() * cm3;
+    }
+  }
+  return fCubicVolume;
 }
 
 //______________________________________________________________________________
@@ -15,16 +15,18 @@
 ///
 /// \author I. Hrivnacova; IPN, Orsay
 
+#include <G4LogicalVolume.hh>
+#include <G4VPhysicalVolume.hh>
 #include <globals.hh>
 
 #include <Rtypes.h>
 
 #include <map>
 #include <set>
+#include <vector>
 
 class TG4SensitiveDetector;
 
-class G4LogicalVolume;
 class G4VSensitiveDetector;
 
 class TVirtualMCSensitiveDetector;
@@ -52,6 +54,7 @@ class TG4SDServices
   void MapVolume(G4LogicalVolume* lv, G4int id, G4bool fillLVToVolIdMap);
   void MapUserSD(
     const G4String& volumeName, TVirtualMCSensitiveDetector* userSD);
+  void BuildVolumeTable();
   void PrintStatistics(G4bool open, G4bool close) const;
   void PrintVolNameToIdMap() const;
   void PrintVolIdToLVMap() const;
@@ -65,6 +68,9 @@ class TG4SDServices
   // volume IDs conversions
   G4int GetVolumeID(const G4String& volumeName) const;
   G4int GetVolumeID(G4LogicalVolume* volume) const;
+  G4int GetVolumeID(
+    const G4VPhysicalVolume* physVolume, G4bool& isDivision) const;
+  const G4String* GetUserVolumeName(const G4LogicalVolume* volume) const;
   G4int GetMediumID(G4LogicalVolume* volume) const;
   G4String GetVolumeName(G4int volumeId) const;
   G4LogicalVolume* GetLogicalVolume(G4int volumeId, G4bool warn = true) const;
@@ -88,6 +94,22 @@ class TG4SDServices
   /// Not implemented
   TG4SDServices& operator=(const TG4SDServices& right);
 
+  /// The division status of the volume placements
+  enum DivisionStatus
+  {
+    kNoDivision,   ///< the volume is placed only as a simple placement
+    kDivision,     ///< the volume is placed only as a division
+    kMixedDivision ///< the volume is placed both ways
+  };
+
+  /// The volume data cached per logical volume
+  struct VolumeInfo
+  {
+    G4int fVolumeID = 0;                    ///< the volume ID
+    DivisionStatus fDivision = kNoDivision; ///< the division status
+    G4String fUserName;                     ///< the user volume name
+  };
+
   // static data members
   static TG4SDServices* fgInstance; ///< this instance
 
@@ -113,6 +135,11 @@ class TG4SDServices
 
   /// info about user SDs
   G4bool fIsUserSDs;
+
+  /// \brief The volume data indexed by the logical volume instance ID
+  /// \details Built once when sensitive detectors are constructed;
+  /// the volumes created later are looked up via the maps
+  std::vector<VolumeInfo> fVolumeTable;
 };
 
 // inline methods
@@ -141,6 +168,42 @@ inline G4bool TG4SDServices::GetIsStopRun() const
   return fIsStopRun;
 }
 
+inline G4int TG4SDServices::GetVolumeID(
+  const G4VPhysicalVolume* physVolume, G4bool& isDivision) const
+{
+  /// Return the volume ID of the logical volume of the given physical volume
+  /// and set the info whether the physical volume is a division
+  /// (replica or parameterised volume).
+
+  G4LogicalVolume* lv = physVolume->GetLogicalVolume();
+  std::size_t index = lv->GetInstanceID();
+  if (index < fVolumeTable.size()) {
+    const VolumeInfo& info = fVolumeTable[index];
+    if (info.fDivision == kMixedDivision) {
+      isDivision = physVolume->IsParameterised() || physVolume->IsReplicated();
+    }
+    else {
+      isDivision = (info.fDivision == kDivision);
+    }
+    return info.fVolumeID;
+  }
+
+  isDivision = physVolume->IsParameterised() || physVolume->IsReplicated();
+  return GetVolumeID(lv);
+}
+
+inline const G4String* TG4SDServices::GetUserVolumeName(
+  const G4LogicalVolume* volume) const
+{
+  /// Return the user volume name of the given logical volume if it is
+  /// available in the volume table, nullptr otherwise.
+
+  std::size_t index = volume->GetInstanceID();
+  if (index < fVolumeTable.size()) return &fVolumeTable[index].fUserName;
+
+  return nullptr;
+}
+
 inline std::set<TVirtualMCSensitiveDetector*>* TG4SDServices::GetUserSDs() const
 {
   /// Returns the user SD vector
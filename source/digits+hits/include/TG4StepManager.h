@@ -17,6 +17,7 @@
 
 #include <Rtypes.h>
 
+#include "TG4StepRecord.h"
 #include "TG4StepStatus.h"
 
 #include <G4GFlashSpot.hh>
@@ -27,6 +28,10 @@
 #include <G4VTouchable.hh>
 #include <globals.hh>
 
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include <TArrayI.h>
 #include <TMCProcess.h>
 #include <TString.h>
@@ -37,6 +42,7 @@ class TG4SteppingAction;
 
 class G4Track;
 class G4SteppingManager;
+class G4ParticleDefinition;
 class G4VPhysicalVolume;
 
 class TLorentzVector;
@@ -148,6 +154,12 @@ class TG4StepManager
   TMCProcess ProdProcess(Int_t isec) const;
   Int_t StepProcesses(TArrayI& proc) const;
 
+  // step snapshot
+  const TG4StepRecord& GetStepRecord(Int_t nofLevels = 1) const; // G4 specific
+
+  // statistics
+  void PrintVolPathCacheStatistics() const; // G4 specific
+
  private:
   /// Not implemented
   TG4StepManager(const TG4StepManager& right);
@@ -164,10 +176,27 @@ class TG4StepManager
   const G4VTouchable* GetCurrentTouchable() const;
   G4VPhysicalVolume* GetCurrentOffPhysicalVolume(
     G4int off, G4bool warn = false) const;
+  Int_t GetVolumeID(G4VPhysicalVolume* physVolume, Int_t& copyNo) const;
+  void FillStepRecord(Int_t nofLevels) const;
+  G4VPhysicalVolume* GetVolPathVolume(
+    const G4VTouchable* touchable, G4int level) const;
+  const std::vector<G4int>& GetAlongStepCodes(
+    const G4ParticleDefinition* particle) const;
+
+  /// The volume path cached per navigation history state
+  struct VolPathEntry
+  {
+    /// the (physical volume, copy number) per history level
+    std::vector<std::pair<const G4VPhysicalVolume*, G4int>> fKey;
+    G4String fPath; ///< the volume path
+  };
 
   // static data members
   static G4ThreadLocal TG4StepManager* fgInstance; ///< this instance
 
+  /// The maximum number of cached volume paths
+  static const std::size_t fgkMaxVolPathCacheSize;
+
   //
   // data members
 
@@ -205,6 +234,28 @@ class TG4StepManager
 
   /// The initial status of a VMC track when it was popped from the VMC stack
   TMCParticleStatus* fInitialVMCTrackStatus;
+
+  /// The snapshot of the current step properties
+  mutable TG4StepRecord fStepRecord;
+
+  /// \brief The number of volume levels filled in fStepRecord
+  /// \details The value -1 means that the record is not filled
+  /// for the current step
+  mutable Int_t fStepRecordLevels;
+
+  /// The volume paths cache (hash of navigation history -> path)
+  std::unordered_map<std::size_t, VolPathEntry> fVolPathCache;
+
+  /// The number of volume path requests served from the cache
+  G4long fVolPathCacheHits;
+
+  /// The number of volume path requests which required building the path
+  G4long fVolPathCacheMisses;
+
+  /// The VMC codes per along step process vector slot, per particle
+  /// (-1 for transportation)
+  mutable std::unordered_map<const G4ParticleDefinition*, std::vector<G4int>>
+    fAlongStepCodes;
 };
 
 // inline methods
@@ -222,6 +273,7 @@ inline void TG4StepManager::SetStep(G4Step* step, TG4StepStatus status)
   fStep = step;
   fStepStatus = status;
   fGflashSpot = 0;
+  fStepRecordLevels = -1;
 }
 
 inline void TG4StepManager::SetStep(G4Track* track, TG4StepStatus status)
@@ -231,6 +283,7 @@ inline void TG4StepManager::SetStep(G4Track* track, TG4StepStatus status)
   fStep = 0;
   fStepStatus = status;
   fGflashSpot = 0;
+  fStepRecordLevels = -1;
 }
 
 inline void TG4StepManager::SetStep(
@@ -242,6 +295,7 @@ inline void TG4StepManager::SetStep(
   fStep = 0;
   fStepStatus = status;
   fGflashSpot = gflashSpot;
+  fStepRecordLevels = -1;
 }
 
 inline void TG4StepManager::SetSteppingManager(G4SteppingManager* manager)
@@ -282,4 +336,17 @@ inline TG4Limits* TG4StepManager::GetLimitsModifiedOnFly() const
   return fLimitsModifiedOnFly;
 }
 
+inline const TG4StepRecord& TG4StepManager::GetStepRecord(
+  Int_t nofLevels) const
+{
+  /// Return the snapshot of the current step properties;
+  /// the record is filled at the first call in the current step
+  /// and then it is reused.
+  /// \param nofLevels  The number of volume levels (the current volume
+  ///                   and its mothers) for which volume IDs are filled
+
+  if (fStepRecordLevels < nofLevels) FillStepRecord(nofLevels);
+  return fStepRecord;
+}
+
 #endif // TG4_STEP_MANAGER_H
@@ -0,0 +1,68 @@
+#ifndef TG4_STEP_RECORD_H
+#define TG4_STEP_RECORD_H
+
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2026 Geant4 VMC developers
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4StepRecord.h
+/// \brief Definition of the TG4StepRecord structure
+///
+/// \author Geant4 VMC developers
+
+#include <Rtypes.h>
+
+/// \ingroup digits_hits
+/// \brief The snapshot of the current step properties
+///
+/// The structure is filled by TG4StepManager::GetStepRecord() in one pass
+/// over the current track, step and touchable, and it is cached for the
+/// current step. All values are given in the VMC (G3) units, the same as
+/// returned by the corresponding TVirtualMC step accessors.
+///
+/// The volume IDs and copy numbers are filled for the current volume
+/// (level 0) and up to fNofLevels-1 mothers; the levels which are not
+/// defined in the geometry are set to 0 (as in CurrentVolOffID).
+///
+/// \author Geant4 VMC developers
+
+struct TG4StepRecord
+{
+  /// The maximum number of volume levels which can be recorded
+  static constexpr Int_t kMaxLevels = 16;
+
+  /// The track status flags
+  enum EStatus
+  {
+    kInside = 1 << 0,      ///< IsTrackInside()
+    kEntering = 1 << 1,    ///< IsTrackEntering()
+    kExiting = 1 << 2,     ///< IsTrackExiting()
+    kOut = 1 << 3,         ///< IsTrackOut()
+    kDisappeared = 1 << 4, ///< IsTrackDisappeared()
+    kStop = 1 << 5,        ///< IsTrackStop()
+    kAlive = 1 << 6,       ///< IsTrackAlive()
+    kNewTrack = 1 << 7     ///< IsNewTrack()
+  };
+
+  /// Return true if the given status flag is set
+  Bool_t Is(EStatus flag) const { return (fStatus & flag) != 0; }
+
+  Int_t fNofLevels;           ///< the number of filled volume levels
+  Int_t fVolID[kMaxLevels];   ///< the volume IDs (CurrentVolOffID)
+  Int_t fCopyNo[kMaxLevels];  ///< the volume copy numbers
+  Double_t fEdep;             ///< the energy deposit (Edep)
+  Double_t fStepLength;       ///< the step length (TrackStep)
+  Double_t fPrePosition[4];   ///< the pre step point position & time
+  Double_t fPostPosition[4];  ///< the post step point position & time
+  Double_t fMomentum[4];      ///< the momentum & total energy
+  Int_t fPid;                 ///< the particle PDG encoding (TrackPid)
+  Double_t fCharge;           ///< the particle charge (TrackCharge)
+  UInt_t fStatus;             ///< the track status flags (EStatus)
+};
+
+#endif // TG4_STEP_RECORD_H
@@ -13,6 +13,7 @@
 /// \author I. Hrivnacova; IPN, Orsay
 
 #include "TG4SDConstruction.h"
+#include "TG4GeometryManager.h"
 #include "TG4GeometryServices.h"
 #include "TG4GflashSensitiveDetector.h"
 #include "TG4SDServices.h"
@@ -140,6 +141,18 @@ void TG4SDConstruction::FillSDSelectionFromTGeo()
       "TG4SDServices", "FillSDSelectionFromTGeo", "TGeo manager not defined.");
   }
 
+  // Use the cached selection if available
+  TG4GeometryCache* geometryCache =
+    TG4GeometryManager::Instance()
+      ? &TG4GeometryManager::Instance()->GetGeometryCache()
+      : 0;
+  if (geometryCache && geometryCache->IsActive() && geometryCache->Load() &&
+      geometryCache->GetSDSelection(fSVLabel, fSelection)) {
+    G4cout << "SD selection (" << fSelection.size()
+           << " volumes) taken from geometry cache" << G4endl;
+    return;
+  }
+
   TObjArray* volumes = gGeoManager->GetListOfVolumes();
   TIterator* it = volumes->MakeIterator();
   TGeoVolume* volume = 0;
@@ -151,6 +164,10 @@ void TG4SDConstruction::FillSDSelectionFromTGeo()
     }
   }
 
+  if (geometryCache && geometryCache->IsActive()) {
+    geometryCache->SetSDSelection(fSVLabel, fSelection);
+  }
+
   if (!fSelection.size()) {
     TString text = "No volumes with the option = \"";
     text += TString(fSVLabel.data());
@@ -282,6 +299,7 @@ void TG4SDConstruction::Construct()
     else {
       MapVolumesToSDIds();
     }
+    TG4SDServices::Instance()->BuildVolumeTable();
   }
 
   // Initialize user geometry
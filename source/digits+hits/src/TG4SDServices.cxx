@@ -20,6 +20,7 @@
 #include <G4LogicalVolume.hh>
 #include <G4LogicalVolumeStore.hh>
 #include <G4Material.hh>
+#include <G4PhysicalVolumeStore.hh>
 #include <G4VSensitiveDetector.hh>
 
 #include <TVirtualMCSensitiveDetector.h>
@@ -40,7 +41,8 @@ TG4SDServices::TG4SDServices()
     fVolNameToIdMap(),
     fVolIdToLVMap(),
     fLVToVolIdMap(),
-    fIsUserSDs(false)
+    fIsUserSDs(false),
+    fVolumeTable()
 {
   /// Default constructor
 
@@ -116,6 +118,55 @@ void TG4SDServices::MapUserSD(
   }
 }
 
+//_____________________________________________________________________________
+void TG4SDServices::BuildVolumeTable()
+{
+  /// Build the table of volume IDs, division status and user volume names
+  /// indexed by the logical volume instance ID.
+  /// It has to be called when the volume IDs are already mapped.
+
+  G4LogicalVolumeStore* lvStore = G4LogicalVolumeStore::GetInstance();
+
+  std::size_t tableSize = 0;
+  for (auto lv : *lvStore) {
+    if (std::size_t(lv->GetInstanceID()) >= tableSize) {
+      tableSize = lv->GetInstanceID() + 1;
+    }
+  }
+
+  // Fill the division status from the volumes placements
+  std::vector<G4int> divisions(tableSize, -1);
+  for (auto pv : *G4PhysicalVolumeStore::GetInstance()) {
+    std::size_t index = pv->GetLogicalVolume()->GetInstanceID();
+    if (index >= tableSize) continue;
+
+    G4int division = (pv->IsParameterised() || pv->IsReplicated())
+                       ? kDivision : kNoDivision;
+    if (divisions[index] == -1) {
+      divisions[index] = division;
+    }
+    else if (divisions[index] != division) {
+      divisions[index] = kMixedDivision;
+    }
+  }
+
+  // Fill the table
+  // (the volume IDs are retrieved before the table is set so that
+  // GetVolumeID does not use the table itself)
+  std::vector<VolumeInfo> volumeTable(tableSize);
+  TG4GeometryServices* geometryServices = TG4GeometryServices::Instance();
+  for (auto lv : *lvStore) {
+    VolumeInfo& info = volumeTable[lv->GetInstanceID()];
+    info.fVolumeID = GetVolumeID(lv);
+    info.fDivision = (divisions[lv->GetInstanceID()] == -1)
+                       ? kNoDivision
+                       : DivisionStatus(divisions[lv->GetInstanceID()]);
+    info.fUserName = geometryServices->UserVolumeName(lv->GetName());
+  }
+
+  fVolumeTable.swap(volumeTable);
+}
+
 //_____________________________________________________________________________
 void TG4SDServices::PrintStatistics(G4bool open, G4bool close) const
 {
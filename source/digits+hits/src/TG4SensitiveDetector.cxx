@@ -14,6 +14,7 @@
 
 #include "TG4SensitiveDetector.h"
 #include "TG4StepManager.h"
+#include "TG4StepProfiler.h"
 
 #include <TVirtualMCApplication.h>
 #include <TVirtualMCSensitiveDetector.h>
@@ -64,6 +65,8 @@ void TG4SensitiveDetector::UserProcessHits()
 {
   /// Call user SD and/or VMC application stepping function.
 
+  TG4ProfilerTimer timer(TG4StepProfiler::kSensitiveDetector);
+
   if (fUserSD) {
     fUserSD->ProcessHits();
   }
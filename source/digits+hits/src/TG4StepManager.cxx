@@ -43,6 +43,7 @@
 #include <TVector3.h>
 
 G4ThreadLocal TG4StepManager* TG4StepManager::fgInstance = 0;
+const std::size_t TG4StepManager::fgkMaxVolPathCacheSize = 10000;
 
 //_____________________________________________________________________________
 TG4StepManager::TG4StepManager(const TString& userGeometry)
@@ -56,7 +57,13 @@ TG4StepManager::TG4StepManager(const TString& userGeometry)
     fCopyNoOffset(0),
     fDivisionCopyNoOffset(0),
     fTrackManager(0),
-    fInitialVMCTrackStatus(0)
+    fInitialVMCTrackStatus(0),
+    fStepRecord(),
+    fStepRecordLevels(-1),
+    fVolPathCache(),
+    fVolPathCacheHits(0),
+    fVolPathCacheMisses(0),
+    fAlongStepCodes()
 {
   /// Standard constructor
   /// \param userGeometry  User selection of geometry definition and navigation
@@ -193,6 +200,147 @@ G4VPhysicalVolume* TG4StepManager::GetCurrentOffPhysicalVolume(
   return touchable->GetVolume(off);
 }
 
+//_____________________________________________________________________________
+G4VPhysicalVolume* TG4StepManager::GetVolPathVolume(
+  const G4VTouchable* touchable, G4int level) const
+{
+  /// Return the physical volume at the given level of the volume path
+  /// (0 = the world volume, depth = the current volume).
+
+  if (level < touchable->GetHistoryDepth()) {
+    return touchable->GetHistory()->GetVolume(level);
+  }
+
+  return GetCurrentPhysicalVolume();
+}
+
+//_____________________________________________________________________________
+const std::vector<G4int>& TG4StepManager::GetAlongStepCodes(
+  const G4ParticleDefinition* particle) const
+{
+  /// Return the VMC codes of the given particle along step processes
+  /// indexed by their slot in the along step process vector (-1 for
+  /// transportation). The codes are filled from the particle process list
+  /// when the particle is met for the first time, so they do not depend on
+  /// the process activation, which only sets the vector slots to 0.
+
+  auto it = fAlongStepCodes.find(particle);
+  if (it != fAlongStepCodes.end()) return it->second;
+
+  G4ProcessManager* processManager = particle->GetProcessManager();
+  std::vector<G4int>& codes = fAlongStepCodes[particle];
+  codes.resize(processManager->GetAlongStepProcessVector()->entries(), -1);
+
+  TG4PhysicsManager* physicsManager = TG4PhysicsManager::Instance();
+  G4ProcessVector* processList = processManager->GetProcessList();
+  for (G4int i = 0; i < G4int(processList->entries()); i++) {
+    G4VProcess* g4Process = (*processList)[i];
+    G4int slot =
+      processManager->GetProcessVectorIndex(g4Process, idxAlongStep, typeDoIt);
+    if (slot < 0 || slot >= G4int(codes.size()) ||
+        g4Process->GetProcessSubType() == TRANSPORTATION)
+      continue;
+    codes[slot] = physicsManager->GetMCProcess(g4Process);
+  }
+  return codes;
+}
+
+//_____________________________________________________________________________
+Int_t TG4StepManager::GetVolumeID(
+  G4VPhysicalVolume* physVolume, Int_t& copyNo) const
+{
+  /// Return the sensitive detector ID of the given physical volume
+  /// and fill its copy number
+
+  // sensitive detector ID
+  G4bool isDivision = false;
+  G4int volumeID =
+    TG4SDServices::Instance()->GetVolumeID(physVolume, isDivision);
+
+  copyNo = physVolume->GetCopyNo() + fCopyNoOffset;
+  if (isDivision) copyNo += fDivisionCopyNoOffset;
+
+  return volumeID;
+}
+
+//_____________________________________________________________________________
+void TG4StepManager::FillStepRecord(Int_t nofLevels) const
+{
+  /// Fill the snapshot of the current step properties in one pass.
+  /// \param nofLevels  The number of volume levels (the current volume
+  ///                   and its mothers) for which volume IDs are filled
+
+#ifdef MCDEBUG
+  CheckTrack();
+#endif
+
+  fStepRecordLevels = nofLevels;
+  if (nofLevels > TG4StepRecord::kMaxLevels) {
+    nofLevels = TG4StepRecord::kMaxLevels;
+  }
+
+  // volume IDs and copy numbers
+  const G4VTouchable* touchable = GetCurrentTouchable();
+  G4int depth = touchable->GetHistoryDepth();
+  for (G4int i = 0; i < nofLevels; ++i) {
+    if (i > depth) {
+      fStepRecord.fVolID[i] = 0;
+      fStepRecord.fCopyNo[i] = 0;
+      continue;
+    }
+    G4VPhysicalVolume* physVolume =
+      (i == 0) ? GetCurrentPhysicalVolume() : touchable->GetVolume(i);
+    fStepRecord.fVolID[i] = GetVolumeID(physVolume, fStepRecord.fCopyNo[i]);
+  }
+  fStepRecord.fNofLevels = nofLevels;
+
+  // energy deposit and step length
+  fStepRecord.fEdep = Edep();
+  fStepRecord.fStepLength = TrackStep();
+
+  // post step point position & time
+  TrackPosition(fStepRecord.fPostPosition[0], fStepRecord.fPostPosition[1],
+    fStepRecord.fPostPosition[2]);
+  fStepRecord.fPostPosition[3] =
+    fTrack->GetGlobalTime() * TG4G3Units::InverseTime();
+
+  // pre step point position & time
+  if (fStepStatus == kNormalStep) {
+    G4StepPoint* preStepPoint = fStep->GetPreStepPoint();
+    const G4ThreeVector& prePosition = preStepPoint->GetPosition();
+    fStepRecord.fPrePosition[0] = prePosition.x() * TG4G3Units::InverseLength();
+    fStepRecord.fPrePosition[1] = prePosition.y() * TG4G3Units::InverseLength();
+    fStepRecord.fPrePosition[2] = prePosition.z() * TG4G3Units::InverseLength();
+    fStepRecord.fPrePosition[3] =
+      preStepPoint->GetGlobalTime() * TG4G3Units::InverseTime();
+  }
+  else {
+    for (G4int i = 0; i < 4; ++i) {
+      fStepRecord.fPrePosition[i] = fStepRecord.fPostPosition[i];
+    }
+  }
+
+  // momentum & energy
+  TrackMomentum(fStepRecord.fMomentum[0], fStepRecord.fMomentum[1],
+    fStepRecord.fMomentum[2], fStepRecord.fMomentum[3]);
+
+  // particle properties
+  fStepRecord.fPid = TrackPid();
+  fStepRecord.fCharge = TrackCharge();
+
+  // track status
+  UInt_t status = 0;
+  if (IsTrackInside()) status |= TG4StepRecord::kInside;
+  if (IsTrackEntering()) status |= TG4StepRecord::kEntering;
+  if (IsTrackExiting()) status |= TG4StepRecord::kExiting;
+  if (fStep && IsTrackOut()) status |= TG4StepRecord::kOut;
+  if (IsTrackDisappeared()) status |= TG4StepRecord::kDisappeared;
+  if (IsTrackStop()) status |= TG4StepRecord::kStop;
+  if (IsTrackAlive()) status |= TG4StepRecord::kAlive;
+  if (IsNewTrack()) status |= TG4StepRecord::kNewTrack;
+  fStepRecord.fStatus = status;
+}
+
 //
 // public methods
 //
@@ -409,13 +557,8 @@ Int_t TG4StepManager::CurrentVolID(Int_t& copyNo) const
       "TG4StepManager", "CurrentVolID", "No current physical volume found");
     return 0;
   }
-  copyNo = physVolume->GetCopyNo() + fCopyNoOffset;
-
-  if (physVolume->IsParameterised() || physVolume->IsReplicated())
-    copyNo += fDivisionCopyNoOffset;
 
-  // sensitive detector ID
-  return TG4SDServices::Instance()->GetVolumeID(physVolume->GetLogicalVolume());
+  return GetVolumeID(physVolume, copyNo);
 }
 
 //_____________________________________________________________________________
@@ -432,13 +575,7 @@ Int_t TG4StepManager::CurrentVolOffID(Int_t off, Int_t& copyNo) const
 #endif
 
   if (mother) {
-    copyNo = mother->GetCopyNo() + fCopyNoOffset;
-
-    if (mother->IsParameterised() || mother->IsReplicated())
-      copyNo += fDivisionCopyNoOffset;
-
-    // sensitive detector ID
-    return TG4SDServices::Instance()->GetVolumeID(mother->GetLogicalVolume());
+    return GetVolumeID(mother, copyNo);
   }
   else {
     copyNo = 0;
@@ -451,8 +588,12 @@ const char* TG4StepManager::CurrentVolName() const
 {
   /// Return the current physical volume name.
 
-  fNameBuffer = TG4GeometryServices::Instance()->UserVolumeName(
-    GetCurrentPhysicalVolume()->GetLogicalVolume()->GetName());
+  G4LogicalVolume* lv = GetCurrentPhysicalVolume()->GetLogicalVolume();
+
+  const G4String* userName = TG4SDServices::Instance()->GetUserVolumeName(lv);
+  if (userName) return userName->data();
+
+  fNameBuffer = TG4GeometryServices::Instance()->UserVolumeName(lv->GetName());
 
   return fNameBuffer.data();
 }
@@ -467,8 +608,13 @@ const char* TG4StepManager::CurrentVolOffName(Int_t off) const
   G4VPhysicalVolume* mother = GetCurrentOffPhysicalVolume(off);
 
   if (mother) {
-    fNameBuffer = TG4GeometryServices::Instance()->UserVolumeName(
-      mother->GetLogicalVolume()->GetName());
+    G4LogicalVolume* lv = mother->GetLogicalVolume();
+    const G4String* userName =
+      TG4SDServices::Instance()->GetUserVolumeName(lv);
+    if (userName) return userName->data();
+
+    fNameBuffer =
+      TG4GeometryServices::Instance()->UserVolumeName(lv->GetName());
   }
   else {
     fNameBuffer = "";
@@ -480,8 +626,9 @@ const char* TG4StepManager::CurrentVolOffName(Int_t off) const
 const char* TG4StepManager::CurrentVolPath()
 {
   /// Return the current volume path.
-
-  TG4GeometryServices* geometryServices = TG4GeometryServices::Instance();
+  /// The paths are cached per navigation history state (the physical volume
+  /// and its copy number at each level), so that the path string is built
+  /// only at the first visit of the given volume path.
 
   // Get current touchable
   const G4VTouchable* touchable = GetCurrentTouchable();
@@ -490,25 +637,75 @@ const char* TG4StepManager::CurrentVolPath()
   //
   G4int depth = touchable->GetHistoryDepth();
 
+  // Compute the hash of the navigation history state
+  //
+  std::size_t key = depth;
+  for (G4int i = 0; i <= depth; i++) {
+    G4VPhysicalVolume* physVolume = GetVolPathVolume(touchable, i);
+    std::size_t pvHash = std::hash<const void*>()(physVolume);
+    std::size_t copyNoHash = std::hash<G4int>()(physVolume->GetCopyNo());
+    key ^= pvHash + 0x9e3779b9 + (key << 6) + (key >> 2);
+    key ^= copyNoHash + 0x9e3779b9 + (key << 6) + (key >> 2);
+  }
+
+  // Return the cached path if the navigation history state matches
+  //
+  auto it = fVolPathCache.find(key);
+  if (it != fVolPathCache.end()) {
+    const VolPathEntry& entry = it->second;
+    G4bool isSame = (G4int(entry.fKey.size()) == depth + 1);
+    for (G4int i = 0; isSame && i <= depth; i++) {
+      G4VPhysicalVolume* physVolume = GetVolPathVolume(touchable, i);
+      isSame = (entry.fKey[i].first == physVolume &&
+                entry.fKey[i].second == physVolume->GetCopyNo());
+    }
+    if (isSame) {
+      ++fVolPathCacheHits;
+      return entry.fPath.data();
+    }
+  }
+
+  ++fVolPathCacheMisses;
+
+  // Keep the cache bounded
+  //
+  if (fVolPathCache.size() >= fgkMaxVolPathCacheSize) {
+    fVolPathCache.clear();
+  }
+
   // Compose the path
   //
-  fNameBuffer = "";
-  for (G4int i = 0; i < depth; i++) {
-    G4VPhysicalVolume* physVolume = touchable->GetHistory()->GetVolume(i);
-    fNameBuffer += "/";
-    fNameBuffer += geometryServices->UserVolumeName(physVolume->GetName());
-    fNameBuffer += "_";
-    TG4Globals::AppendNumberToString(fNameBuffer, physVolume->GetCopyNo());
+  TG4GeometryServices* geometryServices = TG4GeometryServices::Instance();
+
+  VolPathEntry& entry = fVolPathCache[key];
+  entry.fKey.clear();
+  entry.fPath = "";
+  for (G4int i = 0; i <= depth; i++) {
+    G4VPhysicalVolume* physVolume = GetVolPathVolume(touchable, i);
+    entry.fKey.push_back(std::make_pair(physVolume, physVolume->GetCopyNo()));
+    entry.fPath += "/";
+    entry.fPath += geometryServices->UserVolumeName(physVolume->GetName());
+    entry.fPath += "_";
+    TG4Globals::AppendNumberToString(entry.fPath, physVolume->GetCopyNo());
   }
 
-  // Add current volume to the path
-  G4VPhysicalVolume* curPhysVolume = GetCurrentPhysicalVolume();
-  fNameBuffer += "/";
-  fNameBuffer += geometryServices->UserVolumeName(curPhysVolume->GetName());
-  fNameBuffer += "_";
-  TG4Globals::AppendNumberToString(fNameBuffer, curPhysVolume->GetCopyNo());
+  return entry.fPath.data();
+}
+
+//_____________________________________________________________________________
+void TG4StepManager::PrintVolPathCacheStatistics() const
+{
+  /// Print the statistics of the volume paths cache
 
-  return fNameBuffer.data();
+  G4long nofCalls = fVolPathCacheHits + fVolPathCacheMisses;
+  if (!nofCalls) return;
+
+  G4cout << "--- Volume path cache statistics:" << G4endl;
+  G4cout << " Number of CurrentVolPath calls: " << nofCalls << G4endl;
+  G4cout << " Number of cache hits:           " << fVolPathCacheHits << " ("
+         << 100. * fVolPathCacheHits / nofCalls << " %)" << G4endl;
+  G4cout << " Number of cached paths:         " << fVolPathCache.size()
+         << G4endl;
 }
 
 //_____________________________________________________________________________
@@ -1379,11 +1576,11 @@ Int_t TG4StepManager::StepProcesses(TArrayI& processes) const
     // fixes the creator processes
 
   // along step processes
-  G4ProcessVector* processVector = fStep->GetTrack()
-                                     ->GetDefinition()
-                                     ->GetProcessManager()
-                                     ->GetAlongStepProcessVector();
+  const G4ParticleDefinition* particle = fStep->GetTrack()->GetDefinition();
+  G4ProcessVector* processVector =
+    particle->GetProcessManager()->GetAlongStepProcessVector();
   G4int nofAlongStep = processVector->entries();
+  const std::vector<G4int>& alongStepCodes = GetAlongStepCodes(particle);
 
   // process defined step
   const G4VProcess* kpLastProcess =
@@ -1397,13 +1594,13 @@ Int_t TG4StepManager::StepProcesses(TArrayI& processes) const
   // => nofAlongStep + 2
 
   // fill array with (nofAlongStep-1) along step processes
+  // (the inactivated processes are set to 0 in the vector)
   TG4PhysicsManager* physicsManager = TG4PhysicsManager::Instance();
   G4int counter = 0;
   for (G4int i = 0; i < nofAlongStep; i++) {
-    G4VProcess* g4Process = (*processVector)[i];
     // do not fill transportation along step process
-    if (g4Process && g4Process->GetProcessSubType() != TRANSPORTATION)
-      processes[counter++] = physicsManager->GetMCProcess(g4Process);
+    if ((*processVector)[i] && alongStepCodes[i] >= 0)
+      processes[counter++] = alongStepCodes[i];
   }
 
   // fill array with optical photon information
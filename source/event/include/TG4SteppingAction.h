@@ -16,6 +16,7 @@
 /// \author I. Hrivnacova; IPN, Orsay
 
 #include "TG4GeoTrackManager.h"
+#include "TG4StepProfiler.h"
 #include "TG4SteppingActionMessenger.h"
 
 #include <G4UserSteppingAction.hh>
@@ -40,6 +41,8 @@ class G4Step;
 /// It also enables to define a maximum number of steps
 /// and takes care of stopping of a track when this number
 /// is reached.
+/// It owns the (thread-local) step profiler which is activated
+/// via /mcTracking/profile.
 ///
 /// \author I. Hrivnacova; IPN, Orsay
 
@@ -78,6 +81,7 @@ class TG4SteppingAction : public G4UserSteppingAction
   G4int GetMaxNofSteps() const;
   G4bool GetIsPairCut() const;
   G4bool GetCollectTracks() const;
+  TG4StepProfiler& GetStepProfiler();
 
  protected:
   // methods
@@ -107,6 +111,9 @@ class TG4SteppingAction : public G4UserSteppingAction
   /// manager for collecting TGeo tracks
   TG4GeoTrackManager fGeoTrackManager;
 
+  /// step profiler
+  TG4StepProfiler fStepProfiler;
+
   /// the special controls manager
   TG4SpecialControlsV2* fSpecialControls;
 
@@ -210,4 +217,10 @@ inline G4bool TG4SteppingAction::GetCollectTracks() const
   return fCollectTracks;
 }
 
+inline TG4StepProfiler& TG4SteppingAction::GetStepProfiler()
+{
+  /// Return the step profiler
+  return fStepProfiler;
+}
+
 #endif // TG4_STEPPING_ACTION_H
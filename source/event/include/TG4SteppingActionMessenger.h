@@ -21,6 +21,8 @@
 class TG4SteppingAction;
 
 class G4UIdirectory;
+class G4UIcmdWithABool;
+class G4UIcmdWithAString;
 class G4UIcmdWithAnInteger;
 
 /// \ingroup event
@@ -29,6 +31,9 @@ class G4UIcmdWithAnInteger;
 /// Implements commands:
 /// - /mcTracking/loopVerbose [level]
 /// - /mcTracking/maxNofSteps [nofSteps]
+/// - /mcTracking/profile [true|false]
+/// - /mcTracking/profileNofTop nofEntries
+/// - /mcTracking/profileFile fileName
 ///
 /// \author I. Hrivnacova; IPN, Orsay
 
@@ -54,6 +59,9 @@ class TG4SteppingActionMessenger : public G4UImessenger
   TG4SteppingAction* fSteppingAction;    ///< associated class
   G4UIcmdWithAnInteger* fLoopVerboseCmd; ///< command: loopVerbose
   G4UIcmdWithAnInteger* fMaxNofStepsCmd; ///< command: maxNofSteps
+  G4UIcmdWithABool* fProfileCmd;         ///< command: profile
+  G4UIcmdWithAnInteger* fProfileNofTopCmd; ///< command: profileNofTop
+  G4UIcmdWithAString* fProfileFileCmd;   ///< command: profileFile
 };
 
 #endif // TG4_STEPPING_ACTION_MESSENGER_H
@@ -0,0 +1,128 @@
+#ifndef TG4_TRACK_BUFFER_H
+#define TG4_TRACK_BUFFER_H
+
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2026 Geant4 VMC developers
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4TrackBuffer.h
+/// \brief Definition of the TG4TrackRecord and TG4TrackBuffer structures
+///
+/// \author Geant4 VMC developers
+
+#include <Rtypes.h>
+#include <TMCProcess.h>
+
+#include <vector>
+
+/// \ingroup event
+/// \brief The parameters of one track to be pushed to the VMC stack
+///
+/// The parameters are in the VMC (G3) units, with the same meaning as
+/// the arguments of TVirtualMCStack::PushTrack().
+///
+/// \author Geant4 VMC developers
+
+struct TG4TrackRecord
+{
+  Int_t fParent = -1;               ///< the parent track ID
+  Int_t fPdg = 0;                   ///< the PDG encoding
+  Double_t fPx = 0.;                ///< the momentum x component
+  Double_t fPy = 0.;                ///< the momentum y component
+  Double_t fPz = 0.;                ///< the momentum z component
+  Double_t fE = 0.;                 ///< the total energy
+  Double_t fVx = 0.;                ///< the vertex x position
+  Double_t fVy = 0.;                ///< the vertex y position
+  Double_t fVz = 0.;                ///< the vertex z position
+  Double_t fT = 0.;                 ///< the vertex time
+  Double_t fPolX = 0.;              ///< the polarization x component
+  Double_t fPolY = 0.;              ///< the polarization y component
+  Double_t fPolZ = 0.;              ///< the polarization z component
+  TMCProcess fProcess = kPPrimary;  ///< the production process
+  Double_t fWeight = 1.;            ///< the weight
+  Int_t fStatus = 0;                ///< the status
+};
+
+/// \ingroup event
+/// \brief The buffer of tracks to be pushed to the VMC stack in one call
+///
+/// The track parameters are stored in contiguous arrays (one array per
+/// parameter) in the VMC (G3) units, with the same meaning as the arguments
+/// of TVirtualMCStack::PushTrack(). The stack fills the VMC track IDs
+/// of the pushed tracks in fTrackIds.
+///
+/// \author Geant4 VMC developers
+
+struct TG4TrackBuffer
+{
+  /// Return the number of tracks in the buffer
+  std::size_t Size() const { return fPdg.size(); }
+
+  /// Add the track record in the buffer
+  void Add(const TG4TrackRecord& record)
+  {
+    fParent.push_back(record.fParent);
+    fPdg.push_back(record.fPdg);
+    fPx.push_back(record.fPx);
+    fPy.push_back(record.fPy);
+    fPz.push_back(record.fPz);
+    fE.push_back(record.fE);
+    fVx.push_back(record.fVx);
+    fVy.push_back(record.fVy);
+    fVz.push_back(record.fVz);
+    fT.push_back(record.fT);
+    fPolX.push_back(record.fPolX);
+    fPolY.push_back(record.fPolY);
+    fPolZ.push_back(record.fPolZ);
+    fProcess.push_back(record.fProcess);
+    fWeight.push_back(record.fWeight);
+    fStatus.push_back(record.fStatus);
+  }
+
+  /// Clear all arrays
+  void Clear()
+  {
+    fParent.clear();
+    fPdg.clear();
+    fPx.clear();
+    fPy.clear();
+    fPz.clear();
+    fE.clear();
+    fVx.clear();
+    fVy.clear();
+    fVz.clear();
+    fT.clear();
+    fPolX.clear();
+    fPolY.clear();
+    fPolZ.clear();
+    fProcess.clear();
+    fWeight.clear();
+    fStatus.clear();
+    fTrackIds.clear();
+  }
+
+  std::vector<Int_t> fParent;         ///< the parent track IDs
+  std::vector<Int_t> fPdg;            ///< the PDG encodings
+  std::vector<Double_t> fPx;          ///< the momentum x component
+  std::vector<Double_t> fPy;          ///< the momentum y component
+  std::vector<Double_t> fPz;          ///< the momentum z component
+  std::vector<Double_t> fE;           ///< the total energy
+  std::vector<Double_t> fVx;          ///< the vertex x position
+  std::vector<Double_t> fVy;          ///< the vertex y position
+  std::vector<Double_t> fVz;          ///< the vertex z position
+  std::vector<Double_t> fT;           ///< the vertex time
+  std::vector<Double_t> fPolX;        ///< the polarization x component
+  std::vector<Double_t> fPolY;        ///< the polarization y component
+  std::vector<Double_t> fPolZ;        ///< the polarization z component
+  std::vector<TMCProcess> fProcess;   ///< the production processes
+  std::vector<Double_t> fWeight;      ///< the weights
+  std::vector<Int_t> fStatus;         ///< the status
+  std::vector<Int_t> fTrackIds;       ///< the VMC track IDs (filled by stack)
+};
+
+#endif // TG4_TRACK_BUFFER_H
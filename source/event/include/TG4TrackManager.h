@@ -15,6 +15,7 @@
 ///
 /// \author I. Hrivnacova; IPN, Orsay
 
+#include "TG4TrackBuffer.h"
 #include "TG4TrackSaveControl.h"
 #include "TG4Verbose.h"
 
@@ -27,6 +28,7 @@
 
 class TG4TrackInformation;
 class TG4StackPopper;
+class TG4VUserBatchStack;
 
 class TVirtualMCStack;
 class TMCManagerStack;
@@ -47,6 +49,10 @@ class TMCManager;
 /// TG4TrackInformation, which hold the info about
 /// correspondence between Geant4 and VMC stack numbering
 ///
+/// If the VMC stack implements the TG4VUserBatchStack interface,
+/// the secondaries produced in a step are passed to the stack
+/// in one call.
+///
 /// \author I. Hrivnacova; IPN, Orsay
 
 class TG4TrackManager : public TG4Verbose
@@ -96,6 +102,10 @@ class TG4TrackManager : public TG4Verbose
   /// Not implemented
   TG4TrackManager& operator=(const TG4TrackManager& right);
 
+  // methods
+  void FillTrackRecord(const G4Track* track, TG4TrackRecord& record) const;
+  void FlushTrackBuffer(const G4TrackVector* secondaries, G4int first);
+
   // static data members
   static G4ThreadLocal TG4TrackManager* fgInstance; ///< this instance
 
@@ -111,6 +121,13 @@ class TG4TrackManager : public TG4Verbose
   /// Cached pointer to thread-local VMC stack
   TVirtualMCStack* fMCStack;
 
+  /// Cached pointer to thread-local VMC stack if it implements
+  /// the batch interface
+  TG4VUserBatchStack* fBatchStack;
+
+  /// The buffer of tracks to be pushed to the VMC stack
+  TG4TrackBuffer fTrackBuffer;
+
   /// Cached pointer to thread-local TMCManagerStack with additional info on
   /// current transport status
   TMCManagerStack* fMCManagerStack;
@@ -138,12 +155,6 @@ inline TG4TrackManager* TG4TrackManager::Instance()
   return fgInstance;
 }
 
-inline void TG4TrackManager::SetMCStack(TVirtualMCStack* mcStack)
-{
-  /// Set  cached pointer to thread-local VMC stack
-  fMCStack = mcStack;
-}
-
 inline void TG4TrackManager::SetMCManagerStack(TMCManagerStack* mcManagerStack)
 {
   /// Set cached pointer to thread-local TMCManagerStack with additional info on
@@ -0,0 +1,49 @@
+#ifndef TG4_V_USER_BATCH_STACK_H
+#define TG4_V_USER_BATCH_STACK_H
+
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2026 Geant4 VMC developers
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4VUserBatchStack.h
+/// \brief Definition of the TG4VUserBatchStack class
+///
+/// \author Geant4 VMC developers
+
+struct TG4TrackBuffer;
+
+/// \ingroup event
+/// \brief The optional interface for VMC stacks which accept
+/// tracks in batches.
+///
+/// If the user VMC stack (derived from TVirtualMCStack) also derives from
+/// this class, the secondaries produced in one step are passed to the stack
+/// in one PushTracks() call, instead of calling TVirtualMCStack::PushTrack()
+/// for each of them.
+///
+/// \author Geant4 VMC developers
+
+class TG4VUserBatchStack
+{
+ public:
+  TG4VUserBatchStack() {}
+  virtual ~TG4VUserBatchStack() {}
+
+  /// Method to be overriden by user:
+  /// push all tracks from the buffer to the stack (with toBeDone = 0)
+  /// and fill their VMC track IDs in buffer.fTrackIds
+  virtual void PushTracks(TG4TrackBuffer& buffer) = 0;
+
+ private:
+  /// Not implemented
+  TG4VUserBatchStack(const TG4VUserBatchStack& right);
+  /// Not implemented
+  TG4VUserBatchStack& operator=(const TG4VUserBatchStack& right);
+};
+
+#endif // TG4_V_USER_BATCH_STACK_H
@@ -42,6 +42,7 @@ TG4SteppingAction::TG4SteppingAction()
   : G4UserSteppingAction(),
     fMessenger(this),
     fGeoTrackManager(),
+    fStepProfiler(),
     fSpecialControls(0),
     fMCApplication(0),
     fTrackManager(0),
@@ -335,6 +336,13 @@ void TG4SteppingAction::UserSteppingAction(const G4Step* step)
   /// there is defined SteppingAction(const G4Step* step) method
   /// for this purpose.
 
+  // profile this step
+  G4bool isProfiling = fStepProfiler.IsActive();
+  if (isProfiling) {
+    fStepProfiler.StartStep(step);
+    fStepProfiler.StartComponent(TG4StepProfiler::kSteppingAction);
+  }
+
   // Fix creator process for secondaries if using gamma or neutron general process
   ProcessTrackIfGeneralProcess(step);
 
@@ -404,4 +412,9 @@ void TG4SteppingAction::UserSteppingAction(const G4Step* step)
     // track->SetTrackStatus(fStopButAlive);
     track->SetTrackStatus(fAlive);
   }
+
+  if (isProfiling) {
+    fStepProfiler.StopComponent(TG4StepProfiler::kSteppingAction);
+    fStepProfiler.EndStep();
+  }
 }
@@ -16,6 +16,8 @@
 #include "TG4Globals.h"
 #include "TG4SteppingAction.h"
 
+#include <G4UIcmdWithABool.hh>
+#include <G4UIcmdWithAString.hh>
 #include <G4UIcmdWithAnInteger.hh>
 
 //_____________________________________________________________________________
@@ -24,7 +26,10 @@ TG4SteppingActionMessenger::TG4SteppingActionMessenger(
   : G4UImessenger(),
     fSteppingAction(steppingAction),
     fLoopVerboseCmd(0),
-    fMaxNofStepsCmd(0)
+    fMaxNofStepsCmd(0),
+    fProfileCmd(0),
+    fProfileNofTopCmd(0),
+    fProfileFileCmd(0)
 {
   /// Standard constructor
 
@@ -43,6 +48,33 @@ TG4SteppingActionMessenger::TG4SteppingActionMessenger(
   fMaxNofStepsCmd->SetRange("MaxNofSteps >= 0");
   fMaxNofStepsCmd->AvailableForStates(
     G4State_PreInit, G4State_Init, G4State_Idle);
+
+  fProfileCmd = new G4UIcmdWithABool("/mcTracking/profile", this);
+  fProfileCmd->SetGuidance("(In)Activate the per-step cost profiler.");
+  fProfileCmd->SetGuidance(
+    "The time per volume, particle and creator process and the time in");
+  fProfileCmd->SetGuidance(
+    "stepping action, sensitive detectors, field and stack popper are");
+  fProfileCmd->SetGuidance("reported at the end of run.");
+  fProfileCmd->SetParameterName("Profile", true);
+  fProfileCmd->SetDefaultValue(true);
+  fProfileCmd->AvailableForStates(G4State_PreInit, G4State_Init, G4State_Idle);
+
+  fProfileNofTopCmd =
+    new G4UIcmdWithAnInteger("/mcTracking/profileNofTop", this);
+  fProfileNofTopCmd->SetGuidance(
+    "Set the number of the top entries printed in the profiler report.");
+  fProfileNofTopCmd->SetParameterName("NofTop", false);
+  fProfileNofTopCmd->SetRange("NofTop >= 0");
+  fProfileNofTopCmd->AvailableForStates(
+    G4State_PreInit, G4State_Init, G4State_Idle);
+
+  fProfileFileCmd = new G4UIcmdWithAString("/mcTracking/profileFile", this);
+  fProfileFileCmd->SetGuidance(
+    "Set the name of the CSV file where the profiler tables are written.");
+  fProfileFileCmd->SetParameterName("FileName", false);
+  fProfileFileCmd->AvailableForStates(
+    G4State_PreInit, G4State_Init, G4State_Idle);
 }
 
 //_____________________________________________________________________________
@@ -52,6 +84,9 @@ TG4SteppingActionMessenger::~TG4SteppingActionMessenger()
 
   delete fLoopVerboseCmd;
   delete fMaxNofStepsCmd;
+  delete fProfileCmd;
+  delete fProfileNofTopCmd;
+  delete fProfileFileCmd;
 }
 
 //
@@ -71,4 +106,15 @@ void TG4SteppingActionMessenger::SetNewValue(
   else if (command == fMaxNofStepsCmd) {
     fSteppingAction->SetMaxNofSteps(fMaxNofStepsCmd->GetNewIntValue(newValue));
   }
+  else if (command == fProfileCmd) {
+    fSteppingAction->GetStepProfiler().SetIsActive(
+      fProfileCmd->GetNewBoolValue(newValue));
+  }
+  else if (command == fProfileNofTopCmd) {
+    fSteppingAction->GetStepProfiler().SetNofTopEntries(
+      fProfileNofTopCmd->GetNewIntValue(newValue));
+  }
+  else if (command == fProfileFileCmd) {
+    fSteppingAction->GetStepProfiler().SetFileName(newValue);
+  }
 }
@@ -22,6 +22,7 @@
 #include "TG4StackPopper.h"
 #include "TG4StepManager.h"
 #include "TG4TrackInformation.h"
+#include "TG4VUserBatchStack.h"
 
 #ifdef USE_G4ROOT
 #include <TMCManager.h>
@@ -31,6 +32,7 @@
 #include <TMCParticleStatus.h>
 #include <TVirtualMC.h>
 #include <TVirtualMCApplication.h>
+#include <TVirtualMCStack.h>
 
 #include <G4PrimaryParticle.hh>
 #include <G4PrimaryVertex.hh>
@@ -48,6 +50,8 @@ TG4TrackManager::TG4TrackManager()
     fG4TrackingManager(0),
     fTrackSaveControl(kSaveInPreTrack),
     fMCStack(0),
+    fBatchStack(0),
+    fTrackBuffer(),
     fMCManagerStack(0),
     fStackPopper(0),
     fSaveDynamicCharge(false),
@@ -85,6 +89,103 @@ TG4TrackManager::~TG4TrackManager()
   fgInstance = 0;
 }
 
+//
+// private methods
+//
+
+//_____________________________________________________________________________
+void TG4TrackManager::FillTrackRecord(
+  const G4Track* track, TG4TrackRecord& record) const
+{
+  /// Get all needed parameters from G4track and fill them
+  /// in the given track record in the VMC units.
+
+  // parent particle index
+  G4int parentID = track->GetParentID();
+  if (parentID == 0) {
+    record.fParent = -1;
+  }
+  else {
+    record.fParent = GetTrackInformation(track)->GetParentParticleID();
+  }
+
+  // PDG code
+  record.fPdg =
+    TG4ParticlesManager::Instance()->GetPDGEncoding(track->GetDefinition());
+
+  // track kinematics
+  const G4ThreeVector& momentum = track->GetMomentum();
+  record.fPx = momentum.x() * TG4G3Units::InverseEnergy();
+  record.fPy = momentum.y() * TG4G3Units::InverseEnergy();
+  record.fPz = momentum.z() * TG4G3Units::InverseEnergy();
+  record.fE = track->GetTotalEnergy() * TG4G3Units::InverseEnergy();
+
+  const G4ThreeVector& position = track->GetPosition();
+  record.fVx = position.x() * TG4G3Units::InverseLength();
+  record.fVy = position.y() * TG4G3Units::InverseLength();
+  record.fVz = position.z() * TG4G3Units::InverseLength();
+  record.fT = track->GetGlobalTime() * TG4G3Units::InverseTime();
+
+  const G4ThreeVector& polarization = track->GetPolarization();
+  record.fPolX = polarization.x();
+  record.fPolY = polarization.y();
+  record.fPolZ = polarization.z();
+
+  // production process
+  const G4VProcess* kpProcess = track->GetCreatorProcess();
+  if (!kpProcess) {
+    record.fProcess = kPPrimary;
+  }
+  else {
+    record.fProcess = TG4PhysicsManager::Instance()->GetMCProcess(kpProcess);
+    // distinguish kPDeltaRay from kPEnergyLoss
+    if (record.fProcess == kPEnergyLoss) record.fProcess = kPDeltaRay;
+  }
+
+  record.fWeight = track->GetWeight();
+
+  record.fStatus = 0;
+  if (fSaveDynamicCharge) {
+    // Store the dynamic particle charge (which in case of ion may
+    // be different from PDG charge) as status as there is no other
+    // place where we can do it
+    record.fStatus = G4int(track->GetDynamicParticle()->GetCharge() / eplus);
+  }
+}
+
+//_____________________________________________________________________________
+void TG4TrackManager::FlushTrackBuffer(
+  const G4TrackVector* secondaries, G4int first)
+{
+  /// Push the buffered secondaries, starting from the first index
+  /// in the secondaries vector, to the VMC stack in one call
+  /// and set their VMC particle Ids in the track info
+
+  if (!fTrackBuffer.Size()) return;
+
+  fBatchStack->PushTracks(fTrackBuffer);
+
+  if (fTrackBuffer.fTrackIds.size() != fTrackBuffer.Size()) {
+    TString text = "The batch stack returned ";
+    text += G4int(fTrackBuffer.fTrackIds.size());
+    text += " track Ids for ";
+    text += G4int(fTrackBuffer.Size());
+    text += " tracks.";
+    TG4Globals::Exception("TG4TrackManager", "FlushTrackBuffer", text);
+  }
+
+  for (G4int i = 0; i < G4int(fTrackBuffer.Size()); ++i) {
+    GetTrackInformation((*secondaries)[first + i])
+      ->SetTrackParticleID(fTrackBuffer.fTrackIds[i]);
+
+    // Notify a stack popper (if activated) about saving this secondary
+    if (fStackPopper) fStackPopper->Notify();
+  }
+
+  fNofSavedSecondaries += fTrackBuffer.Size();
+  fTrackBuffer.Clear();
+}
+
 //
 // public methods
 //
@@ -282,73 +383,23 @@ void TG4TrackManager::TrackToStack(const G4Track* track, G4bool /*overWrite*/)
 
   if (VerboseLevel() > 2) G4cout << "TG4TrackManager::TrackToStack" << G4endl;
 
-  // parent particle index
-  G4int parentID = track->GetParentID();
-  G4int motherIndex;
-  if (parentID == 0) {
-    motherIndex = -1;
-  }
-  else {
-    motherIndex = GetTrackInformation(track)->GetParentParticleID();
-  }
-
-  // PDG code
-  G4int pdg =
-    TG4ParticlesManager::Instance()->GetPDGEncoding(track->GetDefinition());
-
-  // track kinematics
-  G4ThreeVector momentum = track->GetMomentum();
-  momentum *= 1. / (TG4G3Units::Energy());
-
-  G4double px = momentum.x();
-  G4double py = momentum.y();
-  G4double pz = momentum.z();
-  G4double e = track->GetTotalEnergy() * TG4G3Units::InverseEnergy();
-
-  G4ThreeVector position = track->GetPosition();
-  position *= 1. / (TG4G3Units::Length());
-  G4double vx = position.x();
-  G4double vy = position.y();
-  G4double vz = position.z();
-  G4double t = track->GetGlobalTime() * TG4G3Units::InverseTime();
-
-  G4ThreeVector polarization = track->GetPolarization();
-  G4double polX = polarization.x();
-  G4double polY = polarization.y();
-  G4double polZ = polarization.z();
-
-  // production process
-  TMCProcess mcProcess;
-  const G4VProcess* kpProcess = track->GetCreatorProcess();
-  if (!kpProcess) {
-    mcProcess = kPPrimary;
-  }
-  else {
-    mcProcess = TG4PhysicsManager::Instance()->GetMCProcess(kpProcess);
-    // distinguish kPDeltaRay from kPEnergyLoss
-    if (mcProcess == kPEnergyLoss) mcProcess = kPDeltaRay;
-  }
-
-  G4double weight = track->GetWeight();
-
-  G4int status = 0;
-  if (fSaveDynamicCharge) {
-    // Store the dynamic particle charge (which in case of ion may
-    // be different from PDG charge) as status as there is no other
-    // place where we can do it
-    status = G4int(track->GetDynamicParticle()->GetCharge() / eplus);
-  }
+  TG4TrackRecord record;
+  FillTrackRecord(track, record);
 
   G4int ntr;
 #ifdef STACK_WITH_KEEP_FLAG
   // create particle
-  fMCStack->PushTrack(0, motherIndex, pdg, px, py, pz, e, vx, vy, vz, t, polX,
-    polY, polZ, mcProcess, ntr, weight, status, overWrite);
+  fMCStack->PushTrack(0, record.fParent, record.fPdg, record.fPx, record.fPy,
+    record.fPz, record.fE, record.fVx, record.fVy, record.fVz, record.fT,
+    record.fPolX, record.fPolY, record.fPolZ, record.fProcess, ntr,
+    record.fWeight, record.fStatus, overWrite);
   // Experimental code with flagging tracks in stack for overwrite;
   // not yet available in distribution
 #else
-  fMCStack->PushTrack(0, motherIndex, pdg, px, py, pz, e, vx, vy, vz, t, polX,
-    polY, polZ, mcProcess, ntr, weight, status);
+  fMCStack->PushTrack(0, record.fParent, record.fPdg, record.fPx, record.fPy,
+    record.fPz, record.fE, record.fVx, record.fVy, record.fVz, record.fT,
+    record.fPolX, record.fPolY, record.fPolZ, record.fProcess, ntr,
+    record.fWeight, record.fStatus);
 #endif
   // Explicitly set the VMC particle Id in the track info hence not relying
   // on a certain indexing on the user VMC stack
@@ -424,6 +475,29 @@ void TG4TrackManager::SaveSecondaries(
   // Store parent track Id
   SetParentToTrackInformation(track);
 
+  if (fBatchStack) {
+    // Collect all secondaries in the buffer and push them in one call
+    fTrackBuffer.Clear();
+    G4int first = fNofSavedSecondaries;
+    for (G4int i = first; i < G4int(secondaries->size()); ++i) {
+      G4Track* secondary = (*secondaries)[i];
+
+      if (GetTrackInformation(secondary) &&
+          GetTrackInformation(secondary)->IsUserTrack())
+        break;
+
+      // Set track Id
+      SetTrackInformation(secondary);
+
+      // Add track in the buffer
+      TG4TrackRecord record;
+      FillTrackRecord(secondary, record);
+      fTrackBuffer.Add(record);
+    }
+    FlushTrackBuffer(secondaries, first);
+    return;
+  }
+
   for (G4int i = fNofSavedSecondaries; i < G4int(secondaries->size()); ++i) {
 
     G4Track* secondary = (*secondaries)[i];
@@ -448,6 +522,21 @@ void TG4TrackManager::SaveSecondaries(
   }
 }
 
+//_____________________________________________________________________________
+void TG4TrackManager::SetMCStack(TVirtualMCStack* mcStack)
+{
+  /// Set cached pointer to thread-local VMC stack
+  /// and check whether it implements the batch interface
+
+  fMCStack = mcStack;
+  fBatchStack = dynamic_cast<TG4VUserBatchStack*>(mcStack);
+
+  if (fBatchStack && VerboseLevel() > 0) {
+    G4cout << "The VMC stack implements TG4VUserBatchStack: "
+           << "the secondaries will be saved in batches." << G4endl;
+  }
+}
+
 //_____________________________________________________________________________
 void TG4TrackManager::ResetPrimaryParticleIds()
 {
@@ -22,6 +22,7 @@
 #include "TG4SpecialControlsV2.h"
 #include "TG4StackPopper.h"
 #include "TG4StepManager.h"
+#include "TG4StepProfiler.h"
 #include "TG4TrackInformation.h"
 #include "TG4TrackManager.h"
 
@@ -254,6 +255,10 @@ void TG4TrackingAction::PreUserTrackingAction(const G4Track* track)
       UserProcessHits(track);
     }
   }
+
+  // set the step mark for the profiler (if activated)
+  TG4StepProfiler* profiler = TG4StepProfiler::Instance();
+  if (profiler && profiler->IsActive()) profiler->StartTrack();
 }
 
 //_____________________________________________________________________________
@@ -0,0 +1,71 @@
+#ifndef TG4_BULK_RK4_STEPPER_H
+#define TG4_BULK_RK4_STEPPER_H
+
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2026 Geant4 VMC developers
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4BulkRK4Stepper.h
+/// \brief Definition of the TG4BulkRK4Stepper class
+///
+/// \author Geant4 VMC developers
+
+#include <G4MagErrorStepper.hh>
+#include <globals.hh>
+
+class TG4MagneticField;
+
+class G4Mag_EqRhs;
+
+/// \ingroup geometry
+/// \brief The classical Runge-Kutta 4 stepper with the field evaluated
+/// in several points at once.
+///
+/// The field values in the middle and at the end of each step are obtained
+/// in one TG4MagneticField::GetFieldValues() call, so that they can be
+/// passed to the user bulk field (see TG4VUserBulkMagField), instead of
+/// evaluating the field in each Runge-Kutta stage.
+/// The points are taken along the initial direction of the step; the
+/// middle point is then the exact Runge-Kutta one and the end point differs
+/// from it at the second order in the step length. This deviation is
+/// included in the error estimated by G4MagErrorStepper from two half steps.
+///
+/// The stepper is selected via /mcMagField/stepperType BulkRK4.
+///
+/// \author Geant4 VMC developers
+
+class TG4BulkRK4Stepper : public G4MagErrorStepper
+{
+ public:
+  TG4BulkRK4Stepper(G4Mag_EqRhs* equation);
+  virtual ~TG4BulkRK4Stepper();
+
+  virtual void DumbStepper(const G4double yIn[], const G4double dydx[],
+    G4double h, G4double yOut[]);
+
+  virtual G4int IntegratorOrder() const;
+
+ private:
+  /// Not implemented
+  TG4BulkRK4Stepper();
+  /// Not implemented
+  TG4BulkRK4Stepper(const TG4BulkRK4Stepper& right);
+  /// Not implemented
+  TG4BulkRK4Stepper& operator=(const TG4BulkRK4Stepper& right);
+
+  // data members
+  /// The magnetic field evaluated in several points at once
+  TG4MagneticField* fField;
+};
+
+// inline functions
+
+/// Return the order of the integration method
+inline G4int TG4BulkRK4Stepper::IntegratorOrder() const { return 4; }
+
+#endif // TG4_BULK_RK4_STEPPER_H
@@ -18,6 +18,7 @@
 #include "TG4FieldParameters.h"
 #include "TG4MagneticField.h"
 
+#include <G4Cache.hh>
 #include <G4ThreeVector.hh>
 #include <globals.hh>
 
@@ -38,6 +39,15 @@ class TVirtualMagField;
 /// new point from a previous one is smaller than the value of
 /// TG4FieldParameters::fConstDistance.
 ///
+/// The last fgkNofPoints evaluated points are kept in a thread-local
+/// ring buffer and a new point is looked up by its position only,
+/// so that interleaved tracks (e.g. secondaries) reuse each other's values
+/// when they are close and do not need to know which track is transported.
+/// The field objects are created per thread (see
+/// TG4GeometryManager::ConstructSDandField()), so the counters are per
+/// thread and need no locking; they are merged across threads in
+/// TG4GeometryManager::MergeFieldStatistics().
+///
 /// According to G4CachedMagneticField class.
 ///
 /// \author I. Hrivnacova; IPN, Orsay
@@ -49,25 +59,54 @@ class TG4CachedMagneticField : public TG4MagneticField
   virtual ~TG4CachedMagneticField();
 
   virtual void GetFieldValue(const G4double point[3], G4double* bfield) const;
+  virtual void GetFieldValues(
+    G4int nofPoints, const G4double* points, G4double* bfields) const;
 
   // virtual void Update(const TG4FieldParameters& parameters);
   virtual void PrintStatistics() const;
+  virtual G4bool GetStatistics(G4long& nofCalls, G4long& nofEvaluations) const;
+  virtual void ClearCounter();
 
-  void ClearCounter();
   void SetConstDistance(G4double value);
 
  private:
+  // static data members
+  /// The number of cached points
+  static constexpr G4int fgkNofPoints = 8;
+
+  /// The cached points
+  struct PointCache
+  {
+    /// The number of filled points
+    G4int fNofPoints = 0;
+    /// The index of the point to be overwritten next
+    G4int fNext = 0;
+    /// The evaluated locations
+    G4ThreeVector fLocation[fgkNofPoints];
+    /// The evaluated values
+    G4ThreeVector fValue[fgkNofPoints];
+  };
+
   // data members
-  /// The last evaluated location
-  mutable G4ThreeVector fLastLocation;
-  /// The last evaluated value
-  mutable G4ThreeVector fLastValue;
+  /// The thread-local cached points
+  mutable G4Cache<PointCache> fPointCache;
   /// The counter of calls to GetFieldValue()
-  mutable G4int fCallsCounter;
+  mutable G4long fCallsCounter;
   /// The counter of field value evaluations in GetFieldValue()
-  mutable G4int fEvaluationsCounter;
+  mutable G4long fEvaluationsCounter;
   /// The square of the distance within which the field is considered constant
   G4double fConstDistanceSquare;
 };
 
+// inline functions
+
+/// Get the numbers of calls and user field evaluations
+inline G4bool TG4CachedMagneticField::GetStatistics(
+  G4long& nofCalls, G4long& nofEvaluations) const
+{
+  nofCalls = fCallsCounter;
+  nofEvaluations = fEvaluationsCounter;
+  return true;
+}
+
 #endif // TG4_CACHED_MAGNETIC_FIELD_H
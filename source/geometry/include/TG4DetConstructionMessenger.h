@@ -47,6 +47,10 @@ class G4UIcmdWithADoubleAndUnit;
 /// - /mcDet/setIsMaxStepInLowDensityMaterials true|false
 /// - /mcDet/setMaxStepInLowDensityMaterials value
 /// - /mcDet/setLimitDensity value
+/// - /mcDet/setGeometryCacheFile fileName
+/// - /mcDet/setNativeNavigation volumeName  - for Root navigation only
+/// - /mcDet/setZeroStepPolicy maxZeroSteps nudge [nudgeFactor] [maxNudge]
+///   - for Root navigation only
 /// - /mcDet/setNewRadiator volumeName xtrModel foilNumber
 /// - /mcDet/setRadiatorLayer materialName thickness [fluctuation]
 /// - /mcDet/setRadiatorStrawTube gasMaterialName wallThickness gassThickness
@@ -79,6 +83,7 @@ class TG4DetConstructionMessenger : public G4UImessenger
   void CreateSetNewRadiatorCmd();
   void CreateSetRadiatorLayerCmd();
   void CreateSetRadiatorStrawTubeCmd();
+  void CreateSetZeroStepPolicyCmd();
   /// The following command is deprecated, will be removed in the next version
   void CreateSetRadiatorCmd();
 
@@ -134,6 +139,15 @@ class TG4DetConstructionMessenger : public G4UImessenger
   /// command: setMaxStepInLowDensityMaterials
   G4UIcmdWithADoubleAndUnit* fSetMaxStepInLowDensityMaterialsCmd;
 
+  /// command: setGeometryCacheFile
+  G4UIcmdWithAString* fSetGeometryCacheFileCmd;
+
+  /// command: setNativeNavigation
+  G4UIcmdWithAString* fSetNativeNavigationCmd;
+
+  /// command: setZeroStepPolicy
+  G4UIcommand* fSetZeroStepPolicyCmd;
+
   /// command: setNewRadiator
   G4UIcommand* fSetNewRadiatorCmd;
 
@@ -16,6 +16,7 @@
 /// \author I. Hrivnacova; IPN, Orsay
 
 #include <G4MagneticField.hh>
+#include <G4ThreeVector.hh>
 #include <globals.hh>
 
 class TG4FieldParametersMessenger;
@@ -79,6 +80,7 @@ enum StepperType
   kHelixMixedStepper,  ///< G4HelixMixedStepper
   kHelixSimpleRunge,   ///< G4HelixSimpleRunge
   kNystromRK4,         ///< G4NystromRK4
+  kBulkRK4,            ///< TG4BulkRK4Stepper
   kRKG3Stepper,        ///< G4RKG3_Stepper
   kUserStepper,        ///< User defined stepper
 
@@ -88,6 +90,21 @@ enum StepperType
   kRK547FEq3  ///< G4RK547FEq3
 };
 
+/// The available grids for tabulating the magnetic field
+enum FieldGridType
+{
+  kNoGrid,         ///< no grid, the field is evaluated in each point
+  kCartesianGrid,  ///< regular grid in x, y, z
+  kCylindricalGrid ///< regular grid in r, phi, z
+};
+
+/// The available interpolation methods on the field grid
+enum FieldInterpolationType
+{
+  kLinearInterpolation, ///< trilinear interpolation (8 nodes)
+  kCubicInterpolation   ///< tricubic Catmull-Rom interpolation (64 nodes)
+};
+
 /// \ingroup geometry
 /// \brief The magnetic field parameters
 ///
@@ -118,6 +135,10 @@ class TG4FieldParameters
   static FieldType GetFieldType(const G4String& name);
   static EquationType GetEquationType(const G4String& name);
   static StepperType GetStepperType(const G4String& name);
+  static G4String GridTypeName(FieldGridType grid);
+  static G4String InterpolationTypeName(FieldInterpolationType interpolation);
+  static FieldGridType GetGridType(const G4String& name);
+  static FieldInterpolationType GetInterpolationType(const G4String& name);
 
   // set methods
   void SetFieldType(FieldType field);
@@ -134,6 +155,13 @@ class TG4FieldParameters
   void SetMaximumEpsilonStep(G4double value);
   void SetConstDistance(G4double value);
   void SetIsMonopole(G4bool isMonopole);
+  void SetGridType(FieldGridType grid);
+  void SetInterpolationType(FieldInterpolationType interpolation);
+  void SetGridMinimum(const G4ThreeVector& minimum);
+  void SetGridMaximum(const G4ThreeVector& maximum);
+  void SetGridNofBins(G4int n1, G4int n2, G4int n3);
+  void SetGridCheckFrequency(G4int frequency);
+  void SetBulkEvaluation(G4bool bulkEvaluation);
 
   // get methods
   G4String GetVolumeName() const;
@@ -152,6 +180,13 @@ class TG4FieldParameters
   G4double GetMaximumEpsilonStep() const;
   G4double GetConstDistance() const;
   G4bool GetIsMonopole() const;
+  FieldGridType GetGridType() const;
+  FieldInterpolationType GetInterpolationType() const;
+  G4ThreeVector GetGridMinimum() const;
+  G4ThreeVector GetGridMaximum() const;
+  G4int GetGridNofBins(G4int axis) const;
+  G4int GetGridCheckFrequency() const;
+  G4bool GetBulkEvaluation() const;
 
  private:
   // static data members
@@ -170,6 +205,8 @@ class TG4FieldParameters
   static const G4double fgkDefaultMaximumEpsilonStep;
   /// Default constant distance
   static const G4double fgkDefaultConstDistance;
+  /// Default number of grid bins along each axis
+  static const G4int fgkDefaultGridNofBins;
 
   // data members
   //
@@ -213,6 +250,29 @@ class TG4FieldParameters
   /// An option to create an extra monopole field integrator
   /// which will be activated directly by G4MonopoleTransportation
   G4bool fIsMonopole;
+
+  /// Type of the grid on which the field is tabulated
+  FieldGridType fGridType;
+
+  /// Interpolation method on the field grid
+  FieldInterpolationType fInterpolation;
+
+  /// The grid lower limits (x,y,z) or (r,-,z)
+  G4ThreeVector fGridMinimum;
+
+  /// The grid upper limits (x,y,z) or (r,-,z)
+  G4ThreeVector fGridMaximum;
+
+  /// The number of grid bins along (x,y,z) or (r,phi,z)
+  G4int fGridNofBins[3];
+
+  /// The frequency of checking the interpolated value against the exact
+  /// field (0 = no check)
+  G4int fGridCheckFrequency;
+
+  /// An option to evaluate the field in several points at once via
+  /// TG4VUserBulkMagField, if implemented by the user field
+  G4bool fBulkEvaluation;
 };
 
 // inline functions
@@ -284,6 +344,53 @@ inline void TG4FieldParameters::SetIsMonopole(G4bool isMonopole)
   fIsMonopole = isMonopole;
 }
 
+/// Set the type of the grid on which the field is tabulated
+inline void TG4FieldParameters::SetGridType(FieldGridType grid)
+{
+  fGridType = grid;
+}
+
+/// Set the interpolation method on the field grid
+inline void TG4FieldParameters::SetInterpolationType(
+  FieldInterpolationType interpolation)
+{
+  fInterpolation = interpolation;
+}
+
+/// Set the grid lower limits (x,y,z) or (r,-,z)
+inline void TG4FieldParameters::SetGridMinimum(const G4ThreeVector& minimum)
+{
+  fGridMinimum = minimum;
+}
+
+/// Set the grid upper limits (x,y,z) or (r,-,z)
+inline void TG4FieldParameters::SetGridMaximum(const G4ThreeVector& maximum)
+{
+  fGridMaximum = maximum;
+}
+
+/// Set the number of grid bins along (x,y,z) or (r,phi,z)
+inline void TG4FieldParameters::SetGridNofBins(G4int n1, G4int n2, G4int n3)
+{
+  fGridNofBins[0] = n1;
+  fGridNofBins[1] = n2;
+  fGridNofBins[2] = n3;
+}
+
+/// Set the frequency of checking the interpolated value against the exact
+/// field (0 = no check)
+inline void TG4FieldParameters::SetGridCheckFrequency(G4int frequency)
+{
+  fGridCheckFrequency = frequency;
+}
+
+/// Set the option to evaluate the field in several points at once via
+/// TG4VUserBulkMagField, if implemented by the user field
+inline void TG4FieldParameters::SetBulkEvaluation(G4bool bulkEvaluation)
+{
+  fBulkEvaluation = bulkEvaluation;
+}
+
 /// Return the name of associated volume, if local field
 inline G4String TG4FieldParameters::GetVolumeName() const
 {
@@ -363,4 +470,47 @@ inline G4double TG4FieldParameters::GetConstDistance() const
 /// which will be activated directly by G4MonopoleTransportation
 inline G4bool TG4FieldParameters::GetIsMonopole() const { return fIsMonopole; }
 
+/// Return the type of the grid on which the field is tabulated
+inline FieldGridType TG4FieldParameters::GetGridType() const
+{
+  return fGridType;
+}
+
+/// Return the interpolation method on the field grid
+inline FieldInterpolationType TG4FieldParameters::GetInterpolationType() const
+{
+  return fInterpolation;
+}
+
+/// Return the grid lower limits (x,y,z) or (r,-,z)
+inline G4ThreeVector TG4FieldParameters::GetGridMinimum() const
+{
+  return fGridMinimum;
+}
+
+/// Return the grid upper limits (x,y,z) or (r,-,z)
+inline G4ThreeVector TG4FieldParameters::GetGridMaximum() const
+{
+  return fGridMaximum;
+}
+
+/// Return the number of grid bins along the given axis
+inline G4int TG4FieldParameters::GetGridNofBins(G4int axis) const
+{
+  return fGridNofBins[axis];
+}
+
+/// Return the frequency of checking the interpolated value against the exact
+/// field
+inline G4int TG4FieldParameters::GetGridCheckFrequency() const
+{
+  return fGridCheckFrequency;
+}
+
+/// Return the option to evaluate the field in several points at once
+inline G4bool TG4FieldParameters::GetBulkEvaluation() const
+{
+  return fBulkEvaluation;
+}
+
 #endif // TG4_FIELD_PARAMETERS_H
@@ -27,6 +27,9 @@ class G4UIcmdWithAString;
 class G4UIcmdWithADouble;
 class G4UIcmdWithADoubleAndUnit;
 class G4UIcmdWithABool;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWith3Vector;
+class G4UIcmdWith3VectorAndUnit;
 
 /// \ingroup geometry
 /// \brief Messenger class that defines commands for TG4DetConstruction.
@@ -44,7 +47,7 @@ class G4UIcmdWithABool;
 ///                     SimpleHeum | SimpleRunge | ConstRK4 | ExactHelixStepper
 ///                     | HelixExplicitEuler | HelixHeum | HelixImplicitEuler |
 ///                     HelixMixedStepper | HelixSimpleRunge | NystromRK4 |
-///                     RKG3Stepper
+///                     BulkRK4 | RKG3Stepper
 /// - /mcMagField/setStepMinimum value
 /// - /mcMagField/setDeltaChord  value
 /// - /mcMagField/setDeltaOneStep value
@@ -53,6 +56,15 @@ class G4UIcmdWithABool;
 /// - /mcMagField/setMaximumEpsilonStep value
 /// - /mcMagField/setConstDistance value
 /// - /mcMagField/setIsMonopole true|false
+/// - /mcMagField/setBulkEvaluation true|false
+/// - /mcMagField/gridType gridType \n
+///       gridType = None | Cartesian | Cylindrical
+/// - /mcMagField/gridInterpolation interpolation \n
+///       interpolation = Linear | Cubic
+/// - /mcMagField/setGridMinimum x y z unit
+/// - /mcMagField/setGridMaximum x y z unit
+/// - /mcMagField/setGridNofBins n1 n2 n3
+/// - /mcMagField/setGridCheckFrequency value
 /// - /mcMagField/printParameters
 ///
 /// \author I. Hrivnacova; IPN, Orsay
@@ -115,6 +127,27 @@ class TG4FieldParametersMessenger : public G4UImessenger
   /// command: setIsMonopole
   G4UIcmdWithABool* fSetIsMonopoleCmd;
 
+  /// command: setBulkEvaluation
+  G4UIcmdWithABool* fSetBulkEvaluationCmd;
+
+  /// command: gridType
+  G4UIcmdWithAString* fGridTypeCmd;
+
+  /// command: gridInterpolation
+  G4UIcmdWithAString* fGridInterpolationCmd;
+
+  /// command: setGridMinimum
+  G4UIcmdWith3VectorAndUnit* fSetGridMinimumCmd;
+
+  /// command: setGridMaximum
+  G4UIcmdWith3VectorAndUnit* fSetGridMaximumCmd;
+
+  /// command: setGridNofBins
+  G4UIcmdWith3Vector* fSetGridNofBinsCmd;
+
+  /// command: setGridCheckFrequency
+  G4UIcmdWithAnInteger* fSetGridCheckFrequencyCmd;
+
   /// command: printParameters
   G4UIcmdWithoutParameter* fPrintParametersCmd;
 };
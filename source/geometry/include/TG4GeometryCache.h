@@ -0,0 +1,132 @@
+#ifndef TG4_GEOMETRY_CACHE_H
+#define TG4_GEOMETRY_CACHE_H
+
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2026 Geant4 VMC developers
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4GeometryCache.h
+/// \brief Definition of the TG4GeometryCache class
+///
+/// \author Geant4 VMC developers
+
+#include <globals.hh>
+
+#include <Rtypes.h>
+
+#include <set>
+#include <vector>
+
+class TGeoManager;
+
+/// \ingroup geometry
+/// \brief The persistent cache of the mapping between the Root geometry
+/// and the converted Geant4 geometry.
+///
+/// The cache keeps the medium Ids assigned to the logical volumes (in the
+/// order of G4LogicalVolumeStore, together with the volume names used to
+/// validate this order) and the selection of sensitive volumes
+/// from TGeo; it is written in a binary file and it is reused in the next
+/// jobs if the hash of the Root geometry content (volumes, media, nodes)
+/// is unchanged. The file is activated via /mcDet/setGeometryCacheFile.
+/// It is used only with the Root geometry and it is written once, after
+/// both the medium map and the SD selection are filled, if their data
+/// were not taken from the cache.
+///
+/// The Geant4 geometry objects themselves are always rebuilt, the cache
+/// only avoids the name lookups needed to map them.
+///
+/// \author Geant4 VMC developers
+
+class TG4GeometryCache
+{
+ public:
+  TG4GeometryCache();
+  ~TG4GeometryCache();
+
+  // static methods
+  static ULong64_t ComputeHash(TGeoManager* geoManager);
+
+  // methods
+  G4bool Load();
+  void Save();
+
+  // set methods
+  void SetFileName(const G4String& fileName);
+  void SetMediumIds(const std::vector<G4int>& mediumIds,
+    const std::vector<G4String>& volumeNames);
+  void SetSDSelection(
+    const G4String& label, const std::set<G4String>& selection);
+
+  // get methods
+  G4bool IsActive() const;
+  const std::vector<G4int>& GetMediumIds() const;
+  const std::vector<G4String>& GetVolumeNames() const;
+  G4bool GetSDSelection(
+    const G4String& label, std::set<G4String>& selection) const;
+
+ private:
+  /// Not implemented
+  TG4GeometryCache(const TG4GeometryCache& right);
+  /// Not implemented
+  TG4GeometryCache& operator=(const TG4GeometryCache& right);
+
+  // static data members
+  /// The file format identifier
+  static const UInt_t fgkMagicNumber;
+  /// The file format version
+  static const UInt_t fgkVersion;
+
+  // data members
+  /// The cache file name (no cache is used if empty)
+  G4String fFileName;
+  /// The hash of the current Root geometry
+  ULong64_t fHash;
+  /// The info whether Load() was already called
+  G4bool fIsLoaded;
+  /// The info whether the cached data were modified since Load()
+  G4bool fIsModified;
+  /// The medium Ids per logical volume (-1 if not mapped)
+  std::vector<G4int> fMediumIds;
+  /// The logical volume names in the same order as the medium Ids
+  std::vector<G4String> fVolumeNames;
+  /// The label of the sensitive volumes selection
+  G4String fSDLabel;
+  /// The selection of sensitive volumes
+  std::set<G4String> fSDSelection;
+  /// The info whether the selection of sensitive volumes is defined
+  G4bool fHasSDSelection;
+};
+
+// inline functions
+
+inline void TG4GeometryCache::SetFileName(const G4String& fileName)
+{
+  /// Set the cache file name (no cache is used if empty)
+  fFileName = fileName;
+}
+
+inline G4bool TG4GeometryCache::IsActive() const
+{
+  /// Return true if the cache file is defined
+  return !fFileName.empty();
+}
+
+inline const std::vector<G4int>& TG4GeometryCache::GetMediumIds() const
+{
+  /// Return the medium Ids per logical volume (empty if not available)
+  return fMediumIds;
+}
+
+inline const std::vector<G4String>& TG4GeometryCache::GetVolumeNames() const
+{
+  /// Return the logical volume names in the same order as the medium Ids
+  return fVolumeNames;
+}
+
+#endif // TG4_GEOMETRY_CACHE_H
@@ -17,6 +17,7 @@
 
 #include "TG4DetConstructionMessenger.h"
 #include "TG4FieldParameters.h"
+#include "TG4GeometryCache.h"
 #include "TG4Globals.h"
 #include "TG4Verbose.h"
 
@@ -24,6 +25,7 @@
 
 class TG4Field;
 class TG4GeometryServices;
+class TG4MediumMap;
 class TG4OpGeometryManager;
 class TG4ModelConfigurationManager;
 class TG4BiasingManager;
@@ -90,12 +92,18 @@ class TG4GeometryManager : public TG4Verbose
 
   void SetLimitDensity(G4double density);
   void SetMaxStepInLowDensityMaterials(G4double maxStep);
+  void SetGeometryCacheFile(const G4String& fileName);
+  void SetNativeNavigation(const G4String& volumeName);
+  void SetZeroStepPolicy(G4int maxZeroSteps, G4double nudge,
+    G4double nudgeFactor, G4double maxNudge);
 
   // printing
-  void PrintFieldStatistics() const;
+  void MergeFieldStatistics();
+  void PrintFieldStatistics();
 
   // get methods
   const std::vector<TG4RadiatorDescription*>& GetRadiators() const;
+  TG4GeometryCache& GetGeometryCache();
 
  private:
   /// Not implemented
@@ -111,6 +119,7 @@ class TG4GeometryManager : public TG4Verbose
   void FillMediumMapFromG3();
   void FillMediumMapFromG4();
   void FillMediumMapFromRoot();
+  G4bool MapMediaFromCache(TG4MediumMap* mediumMap);
   void FillMediumMap();
   TG4FieldParameters* GetOrCreateFieldParameters(const G4String& volumeName);
   void CreateField(TVirtualMagField* magField,
@@ -153,9 +162,16 @@ class TG4GeometryManager : public TG4Verbose
   /// Fields
   static G4ThreadLocal std::vector<TG4Field*>* fgFields;
 
+  /// Field statistics (numbers of calls and evaluations) merged from workers,
+  /// per field index in fgFields
+  std::vector<std::pair<G4long, G4long>> fFieldStatistics;
+
   /// Radiators
   std::vector<TG4RadiatorDescription*> fRadiators;
 
+  /// Persistent cache of the Root geometry mapping
+  TG4GeometryCache fGeometryCache;
+
   /// User region construction
   TG4VUserRegionConstruction* fUserRegionConstruction;
 
@@ -232,6 +248,12 @@ inline void TG4GeometryManager::SetMaxStepInLowDensityMaterials(
   fMaxStepInLowDensityMaterials = maxStep;
 }
 
+inline void TG4GeometryManager::SetGeometryCacheFile(const G4String& fileName)
+{
+  /// Set the file of the persistent cache of the Root geometry mapping
+  fGeometryCache.SetFileName(fileName);
+}
+
 inline const std::vector<TG4RadiatorDescription*>&
 TG4GeometryManager::GetRadiators() const
 {
@@ -239,4 +261,10 @@ TG4GeometryManager::GetRadiators() const
   return fRadiators;
 }
 
+inline TG4GeometryCache& TG4GeometryManager::GetGeometryCache()
+{
+  /// Return the persistent cache of the Root geometry mapping
+  return fGeometryCache;
+}
+
 #endif // TG4_GEOMETRY_MANAGER_H
@@ -0,0 +1,220 @@
+#ifndef TG4_GRID_MAGNETIC_FIELD_H
+#define TG4_GRID_MAGNETIC_FIELD_H
+
+//-------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2026 Geant4 VMC developers
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4GridMagneticField.h
+/// \brief Definition of the TG4GridMagneticField class
+///
+/// \author Geant4 VMC developers
+
+#include "TG4FieldParameters.h"
+#include "TG4MagneticField.h"
+
+#include <globals.hh>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <vector>
+
+class TVirtualMagField;
+
+/// \ingroup geometry
+/// \brief The magnetic field defined by the TVirtualMCApplication field
+/// map, tabulated on a grid and interpolated.
+///
+/// Overrides TG4MagneticField::GetFieldValue();
+/// the user field is tabulated on a regular Cartesian (x, y, z) or
+/// cylindrical (r, phi, z) grid defined via TG4FieldParameters and the
+/// returned value is interpolated (trilinear or tricubic Catmull-Rom)
+/// from the grid nodes. The grid nodes are evaluated lazily, when a cell
+/// is touched for the first time; all missing nodes of the interpolation
+/// stencil are evaluated in one TG4MagneticField::GetFieldValues() call,
+/// so that they can be passed to the user bulk field
+/// (see TG4VUserBulkMagField). Outside the grid the user field
+/// is evaluated directly.
+///
+/// The table is shared by the field objects of all threads created with
+/// the same field parameters. It is allocated in blocks of nodes on first
+/// access; each node has an atomic state (empty, being filled, filled),
+/// so a node is evaluated by the thread which claims it first and the other
+/// threads wait until its value is published.
+///
+/// If the check frequency is set, each n-th interpolated value is compared
+/// with the exact field value and the maximum interpolation error is
+/// reported in PrintStatistics().
+///
+/// \author Geant4 VMC developers
+
+class TG4GridMagneticField : public TG4MagneticField
+{
+ public:
+  TG4GridMagneticField(
+    TVirtualMagField* magField, const TG4FieldParameters& parameters);
+  virtual ~TG4GridMagneticField();
+
+  virtual void GetFieldValue(const G4double point[3], G4double* bfield) const;
+  virtual void GetFieldValues(
+    G4int nofPoints, const G4double* points, G4double* bfields) const;
+
+  virtual void PrintStatistics() const;
+  virtual G4bool GetStatistics(G4long& nofCalls, G4long& nofEvaluations) const;
+  virtual void ClearCounter();
+
+ private:
+  /// Not implemented
+  TG4GridMagneticField();
+  /// Not implemented
+  TG4GridMagneticField(const TG4GridMagneticField& right);
+  /// Not implemented
+  TG4GridMagneticField& operator=(const TG4GridMagneticField& right);
+
+  /// The number of nodes in a block of the shared table
+  static const G4int fgkBlockSize = 4096;
+
+  /// The node states in the shared table
+  enum NodeState : unsigned char
+  {
+    kEmptyNode,   ///< the node is not evaluated
+    kFillingNode, ///< the node is being evaluated by some thread
+    kFilledNode   ///< the node value is available
+  };
+
+  /// The block of nodes of the shared table
+  struct Block
+  {
+    /// The tabulated field values (3 per node)
+    G4double fValues[3 * fgkBlockSize];
+    /// The node states
+    std::atomic<unsigned char> fStates[fgkBlockSize];
+  };
+
+  /// The table of the field values shared by threads
+  struct Table
+  {
+    Table(G4long nofNodes);
+    ~Table();
+
+    /// The number of nodes
+    G4long fNofNodes;
+    /// The grid lower limits, bin widths and number of nodes per axis
+    /// (to check the table compatibility)
+    G4double fGrid[9];
+    /// The blocks of nodes (allocated on first access)
+    std::unique_ptr<std::atomic<Block*>[]> fBlocks;
+    /// The number of blocks
+    G4long fNofBlocks;
+    /// The number of filled nodes
+    std::atomic<G4long> fNofFilledNodes;
+  };
+
+  // methods
+  Block* GetBlock(G4long index) const;
+  G4bool ToGridCoordinates(const G4double point[3], G4double gridPoint[3]) const;
+  void Interpolate(const G4double gridPoint[3], G4double* bfield) const;
+  void FillNodes(const G4int indices[3][4], G4int nofPoints) const;
+  void WaitForNode(G4long index) const;
+  void GetNodePosition(G4long index, G4double position[3]) const;
+  G4long GetNodeIndex(G4int i, G4int j, G4int k) const;
+  void CheckValue(const G4double point[3], const G4double* bfield) const;
+
+  // static data members
+  /// The maximum number of grid nodes
+  static const G4long fgkMaxNofNodes;
+  /// The maximum time of waiting for a node filled by another thread (in s)
+  static const G4double fgkMaxWaitTime;
+  /// The shared tables per field parameters
+  static std::map<const TG4FieldParameters*, std::shared_ptr<Table>> fgTables;
+
+  // data members
+  /// The grid type
+  FieldGridType fGridType;
+  /// The interpolation method
+  FieldInterpolationType fInterpolation;
+  /// The grid lower limits in the grid coordinates
+  G4double fMinimum[3];
+  /// The inverse bin widths in the grid coordinates
+  G4double fInverseSpacing[3];
+  /// The bin widths in the grid coordinates
+  G4double fSpacing[3];
+  /// The number of bins along each axis
+  G4int fNofBins[3];
+  /// The number of nodes along each axis
+  G4int fNofNodes[3];
+  /// The info whether the axis is periodic (phi)
+  G4bool fIsPeriodic[3];
+  /// The frequency of checks against the exact field (0 = no check)
+  G4int fCheckFrequency;
+
+  /// The shared table of the field values
+  std::shared_ptr<Table> fTable;
+  /// The buffer for the positions of nodes to be filled
+  mutable std::vector<G4double> fNodePoints;
+  /// The buffer for the indices of nodes to be filled
+  mutable std::vector<G4long> fNodeIndices;
+  /// The buffer for the field values of nodes to be filled
+  mutable std::vector<G4double> fNodeValues;
+  /// The buffer for the indices of nodes filled by other threads
+  mutable std::vector<G4long> fWaitIndices;
+
+  /// The counter of calls to GetFieldValue()
+  mutable G4long fCallsCounter;
+  /// The counter of user field evaluations
+  mutable G4long fEvaluationsCounter;
+  /// The counter of calls outside the grid
+  mutable G4long fOutsideCounter;
+  /// The counter of grid nodes filled by this object
+  mutable G4long fNofFilledNodes;
+  /// The counter of checks against the exact field
+  mutable G4long fChecksCounter;
+  /// The maximum absolute interpolation error
+  mutable G4double fMaxAbsError;
+  /// The maximum relative interpolation error
+  mutable G4double fMaxRelError;
+};
+
+// inline functions
+
+/// Get the numbers of calls and user field evaluations
+inline G4bool TG4GridMagneticField::GetStatistics(
+  G4long& nofCalls, G4long& nofEvaluations) const
+{
+  nofCalls = fCallsCounter;
+  nofEvaluations = fEvaluationsCounter;
+  return true;
+}
+
+/// Return the block of the node with the given index (allocate it if needed)
+inline TG4GridMagneticField::Block* TG4GridMagneticField::GetBlock(
+  G4long index) const
+{
+  std::atomic<Block*>& blockPtr = fTable->fBlocks[index / fgkBlockSize];
+  Block* block = blockPtr.load(std::memory_order_acquire);
+  if (block) return block;
+
+  Block* newBlock = new Block();
+  if (blockPtr.compare_exchange_strong(block, newBlock,
+        std::memory_order_acq_rel, std::memory_order_acquire)) {
+    return newBlock;
+  }
+  // allocated by another thread
+  delete newBlock;
+  return block;
+}
+
+/// Return the index of the node in the table
+inline G4long TG4GridMagneticField::GetNodeIndex(
+  G4int i, G4int j, G4int k) const
+{
+  return (G4long(i) * fNofNodes[1] + j) * fNofNodes[2] + k;
+}
+
+#endif // TG4_GRID_MAGNETIC_FIELD_H
@@ -18,27 +18,56 @@
 #include <G4MagneticField.hh>
 #include <globals.hh>
 
+#include <vector>
+
+class TG4VUserBulkMagField;
+
 class TVirtualMagField;
 
 /// \ingroup geometry
 /// \brief The magnetic field defined via TVirtualMagField.
 ///
+/// The field can be also evaluated in several points at once via
+/// GetFieldValues(); if the bulk evaluation is activated and the user field
+/// implements TG4VUserBulkMagField, all points are passed to the user field
+/// in one call. GetFieldValues() is used by the field grid to fill its nodes
+/// and by the TG4BulkRK4Stepper; the derived fields override it
+/// to apply their own evaluation per point.
+///
 /// \author I. Hrivnacova; IPN, Orsay
 
 class TG4MagneticField : public G4MagneticField
 {
  public:
-  TG4MagneticField(TVirtualMagField* magField);
+  TG4MagneticField(TVirtualMagField* magField, G4bool bulkEvaluation = false);
   virtual ~TG4MagneticField();
 
   virtual void GetFieldValue(const G4double point[3], G4double* bfield) const;
+  virtual void GetFieldValues(
+    G4int nofPoints, const G4double* points, G4double* bfields) const;
 
   virtual void PrintStatistics() const {}
+  virtual G4bool GetStatistics(G4long& nofCalls, G4long& nofEvaluations) const;
+  virtual void ClearCounter() {}
 
  protected:
   // data
   /// The associated TGeo magnetic field
   TVirtualMagField* fVirtualMagField;
+  /// The associated user bulk field interface (if activated and implemented)
+  TG4VUserBulkMagField* fBulkMagField;
+  /// The buffer for points converted in G3 units
+  mutable std::vector<G4double> fPointsBuffer;
 };
 
+// inline functions
+
+/// Get the numbers of calls and user field evaluations;
+/// return false if the field does not collect statistics
+inline G4bool TG4MagneticField::GetStatistics(
+  G4long& /*nofCalls*/, G4long& /*nofEvaluations*/) const
+{
+  return false;
+}
+
 #endif // TG4_MAGNETIC_FIELD_H
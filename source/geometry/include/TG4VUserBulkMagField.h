@@ -0,0 +1,50 @@
+#ifndef TG4_V_USER_BULK_MAG_FIELD_H
+#define TG4_V_USER_BULK_MAG_FIELD_H
+
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2026 Geant4 VMC developers
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4VUserBulkMagField.h
+/// \brief Definition of the TG4VUserBulkMagField class
+///
+/// \author Geant4 VMC developers
+
+#include <Rtypes.h>
+
+/// \ingroup geometry
+/// \brief The optional interface for magnetic fields which can evaluate
+/// the field in several points at once.
+///
+/// If the user magnetic field (derived from TVirtualMagField) also derives
+/// from this class and the bulk evaluation is activated via
+/// /mcMagField/setBulkEvaluation, TG4MagneticField::GetFieldValues() passes
+/// all points in one Field(n, x, B) call, instead of calling
+/// TVirtualMagField::Field() for each of them.
+///
+/// \author Geant4 VMC developers
+
+class TG4VUserBulkMagField
+{
+ public:
+  TG4VUserBulkMagField() {}
+  virtual ~TG4VUserBulkMagField() {}
+
+  /// Method to be overriden by user:
+  /// fill the field values B[3*n] in the points x[3*n] (x0,y0,z0,x1,...);
+  /// the same units as in TVirtualMagField::Field() are used
+  virtual void Field(Int_t n, const Double_t* x, Double_t* B) = 0;
+
+ private:
+  /// Not implemented
+  TG4VUserBulkMagField(const TG4VUserBulkMagField& right);
+  /// Not implemented
+  TG4VUserBulkMagField& operator=(const TG4VUserBulkMagField& right);
+};
+
+#endif // TG4_V_USER_BULK_MAG_FIELD_H
@@ -0,0 +1,89 @@
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2026 Geant4 VMC developers
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4BulkRK4Stepper.cxx
+/// \brief Implementation of the TG4BulkRK4Stepper class
+///
+/// \author Geant4 VMC developers
+
+#include "TG4BulkRK4Stepper.h"
+#include "TG4Globals.h"
+#include "TG4MagneticField.h"
+
+#include <G4FieldTrack.hh>
+#include <G4Mag_EqRhs.hh>
+
+//_____________________________________________________________________________
+TG4BulkRK4Stepper::TG4BulkRK4Stepper(G4Mag_EqRhs* equation)
+  : G4MagErrorStepper(equation, 6),
+    fField(0)
+{
+  /// Standard constructor
+
+  fField = dynamic_cast<TG4MagneticField*>(equation->GetFieldObj());
+  if (!fField) {
+    TG4Globals::Exception("TG4BulkRK4Stepper", "TG4BulkRK4Stepper",
+      "The BulkRK4 stepper requires a field of TG4MagneticField type.");
+  }
+}
+
+//_____________________________________________________________________________
+TG4BulkRK4Stepper::~TG4BulkRK4Stepper()
+{
+  /// Destructor
+}
+
+//
+// public methods
+//
+
+//_____________________________________________________________________________
+void TG4BulkRK4Stepper::DumbStepper(
+  const G4double yIn[], const G4double dydx[], G4double h, G4double yOut[])
+{
+  /// Advance the track by one classical Runge-Kutta 4 step of length h,
+  /// with the field in the middle and at the end of the step evaluated
+  /// in one call.
+
+  const G4int nvar = GetNumberOfVariables();
+
+  // Evaluate the field in the points along the initial direction
+  G4double points[6];
+  G4double bfields[6];
+  for (G4int i = 0; i < 3; ++i) {
+    points[i] = yIn[i] + 0.5 * h * dydx[i];
+    points[3 + i] = yIn[i] + h * dydx[i];
+  }
+  fField->GetFieldValues(2, points, bfields);
+
+  G4EquationOfMotion* equation = GetEquationOfMotion();
+  G4double yTemp[G4FieldTrack::ncompSVEC] = { 0. };
+  G4double dydxMid[G4FieldTrack::ncompSVEC];
+  G4double dydxTemp[G4FieldTrack::ncompSVEC];
+
+  // Second stage
+  for (G4int i = 0; i < nvar; ++i) yTemp[i] = yIn[i] + 0.5 * h * dydx[i];
+  equation->EvaluateRhsGivenB(yTemp, bfields, dydxMid);
+
+  // Third stage
+  for (G4int i = 0; i < nvar; ++i) yTemp[i] = yIn[i] + 0.5 * h * dydxMid[i];
+  equation->EvaluateRhsGivenB(yTemp, bfields, dydxTemp);
+
+  // Fourth stage
+  for (G4int i = 0; i < nvar; ++i) {
+    yTemp[i] = yIn[i] + h * dydxTemp[i];
+    dydxMid[i] += dydxTemp[i];
+  }
+  equation->EvaluateRhsGivenB(yTemp, bfields + 3, dydxTemp);
+
+  // Accumulate the increments with the proper weights
+  for (G4int i = 0; i < nvar; ++i) {
+    yOut[i] = yIn[i] + h / 6. * (dydx[i] + dydxTemp[i] + 2. * dydxMid[i]);
+  }
+}
@@ -15,6 +15,7 @@
 #include "TG4CachedMagneticField.h"
 #include "TG4G3Units.h"
 #include "TG4Globals.h"
+#include "TG4StepProfiler.h"
 
 #include <TVirtualMC.h>
 #include <TVirtualMCApplication.h>
@@ -23,8 +24,7 @@
 TG4CachedMagneticField::TG4CachedMagneticField(
   TVirtualMagField* magField, G4double constDistance)
   : TG4MagneticField(magField),
-    fLastLocation(),
-    fLastValue(),
+    fPointCache(),
     fCallsCounter(0),
     fEvaluationsCounter(0),
     fConstDistanceSquare(constDistance * constDistance)
@@ -48,16 +48,22 @@ void TG4CachedMagneticField::GetFieldValue(
 {
   /// Return the bfield values in the given point.
 
+  TG4ProfilerTimer timer(TG4StepProfiler::kField);
+
   G4ThreeVector newLocation(point[0], point[1], point[2]);
-  G4double distSq = (newLocation - fLastLocation).mag2();
   ++fCallsCounter;
 
-  // Use cached value if within the constant distance
-  if (distSq < fConstDistanceSquare) {
-    bfield[0] = fLastValue.x();
-    bfield[1] = fLastValue.y();
-    bfield[2] = fLastValue.z();
-    return;
+  // Use cached value if within the constant distance;
+  // start from the most recent point
+  PointCache& cache = fPointCache.Get();
+  for (G4int i = 1; i <= cache.fNofPoints; ++i) {
+    G4int index = (cache.fNext - i + fgkNofPoints) % fgkNofPoints;
+    if ((newLocation - cache.fLocation[index]).mag2() < fConstDistanceSquare) {
+      bfield[0] = cache.fValue[index].x();
+      bfield[1] = cache.fValue[index].y();
+      bfield[2] = cache.fValue[index].z();
+      return;
+    }
   }
 
   // New evaluation
@@ -73,8 +79,22 @@ void TG4CachedMagneticField::GetFieldValue(
 
   // Update counter and cache new values
   ++fEvaluationsCounter;
-  fLastLocation = newLocation;
-  fLastValue = G4ThreeVector(bfield[0], bfield[1], bfield[2]);
+  cache.fLocation[cache.fNext] = newLocation;
+  cache.fValue[cache.fNext] = G4ThreeVector(bfield[0], bfield[1], bfield[2]);
+  cache.fNext = (cache.fNext + 1) % fgkNofPoints;
+  if (cache.fNofPoints < fgkNofPoints) ++cache.fNofPoints;
+}
+
+//_____________________________________________________________________________
+void TG4CachedMagneticField::GetFieldValues(
+  G4int nofPoints, const G4double* points, G4double* bfields) const
+{
+  /// Return the bfield values in the given points using the cached values;
+  /// the points and the field values are stored as (x0,y0,z0,x1,...).
+
+  for (G4int i = 0; i < nofPoints; ++i) {
+    GetFieldValue(points + 3 * i, bfields + 3 * i);
+  }
 }
 
 // //_____________________________________________________________________________
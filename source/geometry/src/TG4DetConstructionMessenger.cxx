@@ -45,6 +45,9 @@ TG4DetConstructionMessenger::TG4DetConstructionMessenger(
     fIsMaxStepInLowDensityMaterialsCmd(0),
     fSetLimitDensityCmd(0),
     fSetMaxStepInLowDensityMaterialsCmd(0),
+    fSetGeometryCacheFileCmd(0),
+    fSetNativeNavigationCmd(0),
+    fSetZeroStepPolicyCmd(0),
     fSetNewRadiatorCmd(0),
     fSetRadiatorLayerCmd(0),
     fSetRadiatorStrawTubeCmd(0),
@@ -173,9 +176,35 @@ TG4DetConstructionMessenger::TG4DetConstructionMessenger(
   fSetMaxStepInLowDensityMaterialsCmd->SetUnitCategory("Length");
   fSetMaxStepInLowDensityMaterialsCmd->AvailableForStates(G4State_PreInit);
 
+  fSetGeometryCacheFileCmd =
+    new G4UIcmdWithAString("/mcDet/setGeometryCacheFile", this);
+  fSetGeometryCacheFileCmd->SetGuidance(
+    "Set the file of the persistent cache of the Root geometry mapping");
+  fSetGeometryCacheFileCmd->SetGuidance(
+    "(media assigned to logical volumes and sensitive volumes selection).");
+  fSetGeometryCacheFileCmd->SetGuidance(
+    "The cache is reused if the Root geometry content is unchanged,");
+  fSetGeometryCacheFileCmd->SetGuidance("otherwise it is rebuilt.");
+  fSetGeometryCacheFileCmd->SetParameterName("GeometryCacheFile", false);
+  fSetGeometryCacheFileCmd->AvailableForStates(G4State_PreInit);
+
+  fSetNativeNavigationCmd =
+    new G4UIcmdWithAString("/mcDet/setNativeNavigation", this);
+  fSetNativeNavigationCmd->SetGuidance(
+    "Navigate the subtree of the given volume with the Geant4 navigator");
+  fSetNativeNavigationCmd->SetGuidance(
+    "(using smart voxels) and TGeo elsewhere; the Root geometry is");
+  fSetNativeNavigationCmd->SetGuidance(
+    "converted only once. Available with Root navigation only.");
+  fSetNativeNavigationCmd->SetGuidance(
+    "The command can be applied to more volumes.");
+  fSetNativeNavigationCmd->SetParameterName("VolumeName", false);
+  fSetNativeNavigationCmd->AvailableForStates(G4State_PreInit);
+
   CreateSetNewRadiatorCmd();
   CreateSetRadiatorLayerCmd();
   CreateSetRadiatorStrawTubeCmd();
+  CreateSetZeroStepPolicyCmd();
 
   // This command is now deprecated, will be removed in the next version.
   // It is replaced with a simple setNewRadiator command.
@@ -203,6 +232,9 @@ TG4DetConstructionMessenger::~TG4DetConstructionMessenger()
   delete fIsMaxStepInLowDensityMaterialsCmd;
   delete fSetLimitDensityCmd;
   delete fSetMaxStepInLowDensityMaterialsCmd;
+  delete fSetGeometryCacheFileCmd;
+  delete fSetNativeNavigationCmd;
+  delete fSetZeroStepPolicyCmd;
   delete fSetNewRadiatorCmd;
   delete fSetRadiatorLayerCmd;
   delete fSetRadiatorStrawTubeCmd;
@@ -286,6 +318,44 @@ void TG4DetConstructionMessenger::CreateSetRadiatorStrawTubeCmd()
   fSetRadiatorStrawTubeCmd->AvailableForStates(G4State_PreInit);
 }
 
+//_____________________________________________________________________________
+void TG4DetConstructionMessenger::CreateSetZeroStepPolicyCmd()
+{
+  G4UIparameter* maxZeroSteps = new G4UIparameter("maxZeroSteps", 'i', false);
+  maxZeroSteps->SetGuidance("Number of zero steps before the first nudge.");
+  maxZeroSteps->SetParameterRange("maxZeroSteps > 0 && maxZeroSteps < 50");
+
+  G4UIparameter* nudge = new G4UIparameter("nudge", 'd', false);
+  nudge->SetGuidance("The first nudge step length (mm).");
+
+  G4UIparameter* nudgeFactor = new G4UIparameter("nudgeFactor", 'd', true);
+  nudgeFactor->SetGuidance("The nudge growth factor.");
+  nudgeFactor->SetDefaultValue(10.);
+
+  G4UIparameter* maxNudge = new G4UIparameter("maxNudge", 'd', true);
+  maxNudge->SetGuidance("The maximum nudge step length (mm).");
+  maxNudge->SetDefaultValue(1.);
+
+  fSetZeroStepPolicyCmd = new G4UIcommand("/mcDet/setZeroStepPolicy", this);
+  fSetZeroStepPolicyCmd->SetGuidance(
+    "Set the policy for tracks stuck with zero steps (Root navigation):");
+  fSetZeroStepPolicyCmd->SetGuidance(
+    "after maxZeroSteps zero steps the track is pushed by a nudge step;");
+  fSetZeroStepPolicyCmd->SetGuidance(
+    "for each next nudge of the same track the nudge grows by nudgeFactor");
+  fSetZeroStepPolicyCmd->SetGuidance(
+    "(up to maxNudge) and the number of zero steps is halved.");
+  fSetZeroStepPolicyCmd->SetGuidance(
+    "The volume pairs where tracks are stuck are printed at end of run.");
+  fSetZeroStepPolicyCmd->SetGuidance(
+    "The policy is shared by all threads, it can be set only in PreInit.");
+  fSetZeroStepPolicyCmd->SetParameter(maxZeroSteps);
+  fSetZeroStepPolicyCmd->SetParameter(nudge);
+  fSetZeroStepPolicyCmd->SetParameter(nudgeFactor);
+  fSetZeroStepPolicyCmd->SetParameter(maxNudge);
+  fSetZeroStepPolicyCmd->AvailableForStates(G4State_PreInit);
+}
+
 //_____________________________________________________________________________
 void TG4DetConstructionMessenger::CreateSetRadiatorCmd()
 {
@@ -391,6 +461,25 @@ void TG4DetConstructionMessenger::SetNewValue(
     TG4GeometryManager::Instance()->SetMaxStepInLowDensityMaterials(
       fSetMaxStepInLowDensityMaterialsCmd->GetNewDoubleValue(newValues));
   }
+  else if (command == fSetGeometryCacheFileCmd) {
+    TG4GeometryManager::Instance()->SetGeometryCacheFile(newValues);
+  }
+  else if (command == fSetNativeNavigationCmd) {
+    TG4GeometryManager::Instance()->SetNativeNavigation(newValues);
+  }
+  else if (command == fSetZeroStepPolicyCmd) {
+    // tokenize parameters in a vector
+    std::vector<G4String> parameters;
+    G4Analysis::Tokenize(newValues, parameters);
+
+    G4int maxZeroSteps = G4UIcommand::ConvertToInt(parameters[0]);
+    // lengths in mm (G4 internal unit)
+    G4double nudge = G4UIcommand::ConvertToDouble(parameters[1]);
+    G4double nudgeFactor = G4UIcommand::ConvertToDouble(parameters[2]);
+    G4double maxNudge = G4UIcommand::ConvertToDouble(parameters[3]);
+    TG4GeometryManager::Instance()->SetZeroStepPolicy(
+      maxZeroSteps, nudge, nudgeFactor, maxNudge);
+  }
   else if (command == fSetNewRadiatorCmd) {
     // tokenize parameters in a vector
     std::vector<G4String> parameters;
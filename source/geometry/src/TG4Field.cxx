@@ -13,7 +13,9 @@
 /// \author I. Hrivnacova; IPN, Orsay
 
 #include "TG4Field.h"
+#include "TG4BulkRK4Stepper.h"
 #include "TG4CachedMagneticField.h"
+#include "TG4GridMagneticField.h"
 #include "TG4MagneticField.h"
 // #include "TG4ElectroMagneticField.h"
 // #include "TG4GravityField.h"
@@ -105,12 +107,27 @@ G4Field* TG4Field::CreateG4Field(
   /// the provided field type
 
   if (parameters.GetFieldType() == kMagnetic) {
-    if (parameters.GetConstDistance() > 0.) {
+    // the bulk evaluation is used to fill the grid nodes
+    // and in the BulkRK4 stepper
+    if (parameters.GetBulkEvaluation() &&
+        parameters.GetGridType() == kNoGrid &&
+        parameters.GetStepperType() != kBulkRK4) {
+      TG4Globals::Warning("TG4Field", "CreateG4Field",
+        "The bulk evaluation has no effect without a field grid "
+        "or the BulkRK4 stepper." +
+          TG4Globals::Endl() + "It will not be applied.");
+    }
+
+    if (parameters.GetGridType() != kNoGrid) {
+      fG4Field = new TG4GridMagneticField(magField, parameters);
+    }
+    else if (parameters.GetConstDistance() > 0.) {
       fG4Field =
         new TG4CachedMagneticField(magField, parameters.GetConstDistance());
     }
     else {
-      fG4Field = new TG4MagneticField(magField);
+      fG4Field =
+        new TG4MagneticField(magField, parameters.GetBulkEvaluation());
     }
   }
   // else if ( parameters.GetFieldType() == kElectroMagnetic ) {
@@ -274,6 +291,10 @@ G4MagIntegratorStepper* TG4Field::CreateStepper(
       return new G4NystromRK4(eqRhs);
       break;
 
+    case kBulkRK4:
+      return new TG4BulkRK4Stepper(eqRhs);
+      break;
+
     case kRKG3Stepper:
       return new G4RKG3_Stepper(eqRhs);
       break;
@@ -31,6 +31,7 @@ const G4double TG4FieldParameters::fgkDefaultDeltaIntersection = 0.001 * mm;
 const G4double TG4FieldParameters::fgkDefaultMinimumEpsilonStep = 5.0e-5;
 const G4double TG4FieldParameters::fgkDefaultMaximumEpsilonStep = 0.001;
 const G4double TG4FieldParameters::fgkDefaultConstDistance = 0.;
+const G4int TG4FieldParameters::fgkDefaultGridNofBins = 50;
 
 //
 // static methods
@@ -124,6 +125,8 @@ G4String TG4FieldParameters::StepperTypeName(StepperType stepper)
       return G4String("HelixSimpleRunge");
     case kNystromRK4:
       return G4String("NystromRK4");
+    case kBulkRK4:
+      return G4String("BulkRK4");
     case kRKG3Stepper:
       return G4String("RKG3_Stepper");
     case kTsitourasRK45:
@@ -143,6 +146,43 @@ G4String TG4FieldParameters::StepperTypeName(StepperType stepper)
   return G4String();
 }
 
+//_____________________________________________________________________________
+G4String TG4FieldParameters::GridTypeName(FieldGridType grid)
+{
+  /// Return the grid type as a string
+
+  switch (grid) {
+    case kNoGrid:
+      return G4String("None");
+    case kCartesianGrid:
+      return G4String("Cartesian");
+    case kCylindricalGrid:
+      return G4String("Cylindrical");
+  }
+
+  TG4Globals::Exception(
+    "TG4FieldParameters", "GridTypeName:", "Unknown grid value.");
+  return G4String();
+}
+
+//_____________________________________________________________________________
+G4String TG4FieldParameters::InterpolationTypeName(
+  FieldInterpolationType interpolation)
+{
+  /// Return the interpolation type as a string
+
+  switch (interpolation) {
+    case kLinearInterpolation:
+      return G4String("Linear");
+    case kCubicInterpolation:
+      return G4String("Cubic");
+  }
+
+  TG4Globals::Exception("TG4FieldParameters", "InterpolationTypeName:",
+    "Unknown interpolation value.");
+  return G4String();
+}
+
 //_____________________________________________________________________________
 FieldType TG4FieldParameters::GetFieldType(const G4String& name)
 {
@@ -197,6 +237,7 @@ StepperType TG4FieldParameters::GetStepperType(const G4String& name)
   if (name == StepperTypeName(kHelixMixedStepper)) return kHelixMixedStepper;
   if (name == StepperTypeName(kHelixSimpleRunge)) return kHelixSimpleRunge;
   if (name == StepperTypeName(kNystromRK4)) return kNystromRK4;
+  if (name == StepperTypeName(kBulkRK4)) return kBulkRK4;
   if (name == StepperTypeName(kRKG3Stepper)) return kRKG3Stepper;
   if (name == StepperTypeName(kRK547FEq1)) return kRK547FEq1;
   if (name == StepperTypeName(kRK547FEq2)) return kRK547FEq2;
@@ -209,6 +250,36 @@ StepperType TG4FieldParameters::GetStepperType(const G4String& name)
   return kClassicalRK4;
 }
 
+//_____________________________________________________________________________
+FieldGridType TG4FieldParameters::GetGridType(const G4String& name)
+{
+  /// Return the grid type for given grid type name
+
+  if (name == GridTypeName(kNoGrid)) return kNoGrid;
+  if (name == GridTypeName(kCartesianGrid)) return kCartesianGrid;
+  if (name == GridTypeName(kCylindricalGrid)) return kCylindricalGrid;
+
+  TG4Globals::Exception(
+    "TG4FieldParameters", "GetGridType:", "Unknown grid name.");
+  return kNoGrid;
+}
+
+//_____________________________________________________________________________
+FieldInterpolationType TG4FieldParameters::GetInterpolationType(
+  const G4String& name)
+{
+  /// Return the interpolation type for given interpolation type name
+
+  if (name == InterpolationTypeName(kLinearInterpolation))
+    return kLinearInterpolation;
+  if (name == InterpolationTypeName(kCubicInterpolation))
+    return kCubicInterpolation;
+
+  TG4Globals::Exception("TG4FieldParameters", "GetInterpolationType:",
+    "Unknown interpolation name.");
+  return kLinearInterpolation;
+}
+
 //
 // ctors, dtor
 //
@@ -229,10 +300,20 @@ TG4FieldParameters::TG4FieldParameters(const G4String& volumeName)
     fUserEquation(0),
     fUserStepper(0),
     fConstDistance(0),
-    fIsMonopole(false)
+    fIsMonopole(false),
+    fGridType(kNoGrid),
+    fInterpolation(kLinearInterpolation),
+    fGridMinimum(),
+    fGridMaximum(),
+    fGridCheckFrequency(0),
+    fBulkEvaluation(false)
 {
   /// Default constructor
 
+  fGridNofBins[0] = fgkDefaultGridNofBins;
+  fGridNofBins[1] = fgkDefaultGridNofBins;
+  fGridNofBins[2] = fgkDefaultGridNofBins;
+
   fMessenger = new TG4FieldParametersMessenger(this);
 }
 
@@ -263,11 +344,23 @@ void TG4FieldParameters::PrintParameters() const
          << "  minStep = " << fStepMinimum << " mm" << G4endl
          << "  constDistance = " << fConstDistance << " mm" << G4endl
          << "  isMonopole = " << std::boolalpha << fIsMonopole << G4endl
+         << "  bulkEvaluation = " << std::boolalpha << fBulkEvaluation
+         << G4endl
          << "  deltaChord = " << fDeltaChord << " mm" << G4endl
          << "  deltaOneStep = " << fDeltaOneStep << " mm" << G4endl
          << "  deltaIntersection = " << fDeltaIntersection << " mm" << G4endl
          << "  epsMin = " << fMinimumEpsilonStep << G4endl
          << "  epsMax=  " << fMaximumEpsilonStep << G4endl;
+  if (fGridType != kNoGrid) {
+    G4cout << "  grid type = " << GridTypeName(fGridType) << G4endl
+           << "  grid interpolation = " << InterpolationTypeName(fInterpolation)
+           << G4endl
+           << "  grid minimum = " << fGridMinimum << " mm" << G4endl
+           << "  grid maximum = " << fGridMaximum << " mm" << G4endl
+           << "  grid bins = " << fGridNofBins[0] << " " << fGridNofBins[1]
+           << " " << fGridNofBins[2] << G4endl
+           << "  grid check frequency = " << fGridCheckFrequency << G4endl;
+  }
 }
 
 //_____________________________________________________________________________
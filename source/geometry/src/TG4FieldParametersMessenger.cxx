@@ -15,10 +15,13 @@
 #include "TG4FieldParametersMessenger.h"
 #include "TG4FieldParameters.h"
 
+#include <G4UIcmdWith3Vector.hh>
+#include <G4UIcmdWith3VectorAndUnit.hh>
 #include <G4UIcmdWithABool.hh>
 #include <G4UIcmdWithADouble.hh>
 #include <G4UIcmdWithADoubleAndUnit.hh>
 #include <G4UIcmdWithAString.hh>
+#include <G4UIcmdWithAnInteger.hh>
 #include <G4UIcmdWithoutParameter.hh>
 #include <G4UIdirectory.hh>
 
@@ -39,6 +42,13 @@ TG4FieldParametersMessenger::TG4FieldParametersMessenger(
     fSetMaximumEpsilonStepCmd(0),
     fSetConstDistanceCmd(0),
     fSetIsMonopoleCmd(0),
+    fSetBulkEvaluationCmd(0),
+    fGridTypeCmd(0),
+    fGridInterpolationCmd(0),
+    fSetGridMinimumCmd(0),
+    fSetGridMaximumCmd(0),
+    fSetGridNofBinsCmd(0),
+    fSetGridCheckFrequencyCmd(0),
     fPrintParametersCmd(0)
 {
   /// Standard constructor
@@ -182,6 +192,95 @@ TG4FieldParametersMessenger::TG4FieldParametersMessenger(
   fSetIsMonopoleCmd->SetParameterName("IsMonopole", false);
   fSetIsMonopoleCmd->AvailableForStates(G4State_PreInit);
 
+  commandName = directoryName;
+  commandName.append("setBulkEvaluation");
+  fSetBulkEvaluationCmd = new G4UIcmdWithABool(commandName, this);
+  fSetBulkEvaluationCmd->SetGuidance(
+    "Evaluate the field in several points at once, if the user field");
+  fSetBulkEvaluationCmd->SetGuidance("implements TG4VUserBulkMagField.");
+  fSetBulkEvaluationCmd->SetGuidance(
+    "It is applied only with a field grid (see gridType) or with");
+  fSetBulkEvaluationCmd->SetGuidance("the BulkRK4 stepper (see stepperType).");
+  fSetBulkEvaluationCmd->SetParameterName("BulkEvaluation", false);
+  fSetBulkEvaluationCmd->AvailableForStates(G4State_PreInit);
+
+  commandName = directoryName;
+  commandName.append("gridType");
+  fGridTypeCmd = new G4UIcmdWithAString(commandName, this);
+  fGridTypeCmd->SetGuidance(
+    "Select the grid on which the field is tabulated and interpolated.");
+  fGridTypeCmd->SetGuidance(
+    "None: the field is evaluated in each point (default);");
+  fGridTypeCmd->SetGuidance("Cartesian: regular grid in (x, y, z);");
+  fGridTypeCmd->SetGuidance(
+    "Cylindrical: regular grid in (r, phi, z), phi covers the full circle.");
+  fGridTypeCmd->SetParameterName("GridType", false);
+  candidates = "";
+  for (G4int i = kNoGrid; i <= kCylindricalGrid; i++) {
+    FieldGridType gt = (FieldGridType)i;
+    candidates += TG4FieldParameters::GridTypeName(gt);
+    candidates += " ";
+  }
+  fGridTypeCmd->SetCandidates(candidates);
+  fGridTypeCmd->AvailableForStates(G4State_PreInit);
+
+  commandName = directoryName;
+  commandName.append("gridInterpolation");
+  fGridInterpolationCmd = new G4UIcmdWithAString(commandName, this);
+  fGridInterpolationCmd->SetGuidance(
+    "Select the interpolation method on the field grid.");
+  fGridInterpolationCmd->SetParameterName("Interpolation", false);
+  candidates = "";
+  for (G4int i = kLinearInterpolation; i <= kCubicInterpolation; i++) {
+    FieldInterpolationType it = (FieldInterpolationType)i;
+    candidates += TG4FieldParameters::InterpolationTypeName(it);
+    candidates += " ";
+  }
+  fGridInterpolationCmd->SetCandidates(candidates);
+  fGridInterpolationCmd->AvailableForStates(G4State_PreInit);
+
+  commandName = directoryName;
+  commandName.append("setGridMinimum");
+  fSetGridMinimumCmd = new G4UIcmdWith3VectorAndUnit(commandName, this);
+  fSetGridMinimumCmd->SetGuidance("Set the field grid lower limits.");
+  fSetGridMinimumCmd->SetGuidance(
+    "(x, y, z) for Cartesian grid, (r, -, z) for cylindrical grid.");
+  fSetGridMinimumCmd->SetParameterName("Min1", "Min2", "Min3", false);
+  fSetGridMinimumCmd->SetDefaultUnit("mm");
+  fSetGridMinimumCmd->SetUnitCategory("Length");
+  fSetGridMinimumCmd->AvailableForStates(G4State_PreInit);
+
+  commandName = directoryName;
+  commandName.append("setGridMaximum");
+  fSetGridMaximumCmd = new G4UIcmdWith3VectorAndUnit(commandName, this);
+  fSetGridMaximumCmd->SetGuidance("Set the field grid upper limits.");
+  fSetGridMaximumCmd->SetGuidance(
+    "(x, y, z) for Cartesian grid, (r, -, z) for cylindrical grid.");
+  fSetGridMaximumCmd->SetParameterName("Max1", "Max2", "Max3", false);
+  fSetGridMaximumCmd->SetDefaultUnit("mm");
+  fSetGridMaximumCmd->SetUnitCategory("Length");
+  fSetGridMaximumCmd->AvailableForStates(G4State_PreInit);
+
+  commandName = directoryName;
+  commandName.append("setGridNofBins");
+  fSetGridNofBinsCmd = new G4UIcmdWith3Vector(commandName, this);
+  fSetGridNofBinsCmd->SetGuidance(
+    "Set the number of field grid bins along (x, y, z) or (r, phi, z).");
+  fSetGridNofBinsCmd->SetParameterName("N1", "N2", "N3", false);
+  fSetGridNofBinsCmd->SetRange("N1 >= 1 && N2 >= 1 && N3 >= 1");
+  fSetGridNofBinsCmd->AvailableForStates(G4State_PreInit);
+
+  commandName = directoryName;
+  commandName.append("setGridCheckFrequency");
+  fSetGridCheckFrequencyCmd = new G4UIcmdWithAnInteger(commandName, this);
+  fSetGridCheckFrequencyCmd->SetGuidance(
+    "Compare each n-th interpolated value with the exact field value");
+  fSetGridCheckFrequencyCmd->SetGuidance(
+    "and report the maximum interpolation error; 0 = no check.");
+  fSetGridCheckFrequencyCmd->SetParameterName("Frequency", false);
+  fSetGridCheckFrequencyCmd->SetRange("Frequency >= 0");
+  fSetGridCheckFrequencyCmd->AvailableForStates(G4State_PreInit);
+
   commandName = directoryName;
   commandName.append("printParameters");
   fPrintParametersCmd = new G4UIcmdWithoutParameter(commandName, this);
@@ -207,6 +306,13 @@ TG4FieldParametersMessenger::~TG4FieldParametersMessenger()
   delete fSetMaximumEpsilonStepCmd;
   delete fSetConstDistanceCmd;
   delete fSetIsMonopoleCmd;
+  delete fSetBulkEvaluationCmd;
+  delete fGridTypeCmd;
+  delete fGridInterpolationCmd;
+  delete fSetGridMinimumCmd;
+  delete fSetGridMaximumCmd;
+  delete fSetGridNofBinsCmd;
+  delete fSetGridCheckFrequencyCmd;
 }
 
 //
@@ -278,6 +384,34 @@ void TG4FieldParametersMessenger::SetNewValue(
     fFieldParameters->SetIsMonopole(
       fSetIsMonopoleCmd->GetNewBoolValue(newValues));
   }
+  else if (command == fSetBulkEvaluationCmd) {
+    fFieldParameters->SetBulkEvaluation(
+      fSetBulkEvaluationCmd->GetNewBoolValue(newValues));
+  }
+  else if (command == fGridTypeCmd) {
+    fFieldParameters->SetGridType(TG4FieldParameters::GetGridType(newValues));
+  }
+  else if (command == fGridInterpolationCmd) {
+    fFieldParameters->SetInterpolationType(
+      TG4FieldParameters::GetInterpolationType(newValues));
+  }
+  else if (command == fSetGridMinimumCmd) {
+    fFieldParameters->SetGridMinimum(
+      fSetGridMinimumCmd->GetNew3VectorValue(newValues));
+  }
+  else if (command == fSetGridMaximumCmd) {
+    fFieldParameters->SetGridMaximum(
+      fSetGridMaximumCmd->GetNew3VectorValue(newValues));
+  }
+  else if (command == fSetGridNofBinsCmd) {
+    G4ThreeVector nofBins = fSetGridNofBinsCmd->GetNew3VectorValue(newValues);
+    fFieldParameters->SetGridNofBins(
+      G4int(nofBins.x()), G4int(nofBins.y()), G4int(nofBins.z()));
+  }
+  else if (command == fSetGridCheckFrequencyCmd) {
+    fFieldParameters->SetGridCheckFrequency(
+      fSetGridCheckFrequencyCmd->GetNewIntValue(newValues));
+  }
   else if (command == fPrintParametersCmd) {
     fFieldParameters->PrintParameters();
   }
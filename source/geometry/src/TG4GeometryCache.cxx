@@ -0,0 +1,317 @@
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2026 Geant4 VMC developers
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4GeometryCache.cxx
+/// \brief Implementation of the TG4GeometryCache class
+///
+/// \author Geant4 VMC developers
+
+#include "TG4GeometryCache.h"
+#include "TG4Globals.h"
+
+#include <TGeoManager.h>
+#include <TGeoMaterial.h>
+#include <TGeoMedium.h>
+#include <TGeoNode.h>
+#include <TGeoShape.h>
+#include <TGeoVolume.h>
+#include <TList.h>
+#include <TObjArray.h>
+
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+/// The FNV-1a 64-bit offset basis
+const ULong64_t kHashOffset = 14695981039346656037ULL;
+/// The FNV-1a 64-bit prime
+const ULong64_t kHashPrime = 1099511628211ULL;
+
+/// Add the given bytes in the FNV-1a hash
+void HashBytes(ULong64_t& hash, const void* data, size_t size)
+{
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= bytes[i];
+    hash *= kHashPrime;
+  }
+}
+
+/// Add the given value in the FNV-1a hash
+template <typename T>
+void HashValue(ULong64_t& hash, T value)
+{
+  HashBytes(hash, &value, sizeof(T));
+}
+
+/// Add the given string (including the terminating character) in the hash
+void HashString(ULong64_t& hash, const char* text)
+{
+  if (!text) text = "";
+  HashBytes(hash, text, std::strlen(text) + 1);
+}
+
+/// Write the value in the binary stream
+template <typename T>
+void WriteValue(std::ofstream& output, T value)
+{
+  output.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+/// Read the value from the binary stream
+template <typename T>
+G4bool ReadValue(std::ifstream& input, T& value)
+{
+  input.read(reinterpret_cast<char*>(&value), sizeof(T));
+  return input.good();
+}
+
+/// Write the string (its size and characters) in the binary stream
+void WriteString(std::ofstream& output, const G4String& text)
+{
+  WriteValue<UInt_t>(output, text.size());
+  output.write(text.data(), text.size());
+}
+
+/// Read the string from the binary stream
+G4bool ReadString(std::ifstream& input, G4String& text)
+{
+  UInt_t size = 0;
+  if (!ReadValue(input, size)) return false;
+  std::string buffer(size, ' ');
+  input.read(&buffer[0], size);
+  text = buffer;
+  return input.good();
+}
+} // namespace
+
+const UInt_t TG4GeometryCache::fgkMagicNumber = 0x54473443; // "TG4C"
+const UInt_t TG4GeometryCache::fgkVersion = 2;
+
+//_____________________________________________________________________________
+TG4GeometryCache::TG4GeometryCache()
+  : fFileName(),
+    fHash(0),
+    fIsLoaded(false),
+    fIsModified(false),
+    fMediumIds(),
+    fVolumeNames(),
+    fSDLabel(),
+    fSDSelection(),
+    fHasSDSelection(false)
+{
+  /// Default constructor
+}
+
+//_____________________________________________________________________________
+TG4GeometryCache::~TG4GeometryCache()
+{
+  /// Destructor
+}
+
+//
+// static methods
+//
+
+//_____________________________________________________________________________
+ULong64_t TG4GeometryCache::ComputeHash(TGeoManager* geoManager)
+{
+  /// Compute the hash of the Root geometry content relevant for the mapping:
+  /// the media (Id, name, material, parameters) and the volumes (name,
+  /// shape type, medium, option and daughters).
+  /// The cost is linear in the number of volumes and nodes
+  /// (not physical instances).
+
+  ULong64_t hash = kHashOffset;
+  if (!geoManager) return hash;
+
+  TIter nextMedium(geoManager->GetListOfMedia());
+  TGeoMedium* medium;
+  while ((medium = (TGeoMedium*)nextMedium())) {
+    HashValue(hash, medium->GetId());
+    HashString(hash, medium->GetName());
+    HashString(hash, medium->GetMaterial()->GetName());
+    for (Int_t i = 0; i < 20; ++i) HashValue(hash, medium->GetParam(i));
+  }
+
+  TObjArray* volumes = geoManager->GetListOfVolumes();
+  for (Int_t i = 0; i < volumes->GetEntriesFast(); ++i) {
+    TGeoVolume* volume = static_cast<TGeoVolume*>(volumes->At(i));
+    if (!volume) continue;
+    HashString(hash, volume->GetName());
+    HashString(hash, volume->GetShape()->ClassName());
+    HashValue(hash, volume->GetMedium() ? volume->GetMedium()->GetId() : -1);
+    HashString(hash, volume->GetOption());
+    Int_t nofDaughters = volume->GetNdaughters();
+    HashValue(hash, nofDaughters);
+    for (Int_t j = 0; j < nofDaughters; ++j) {
+      TGeoNode* node = volume->GetNode(j);
+      HashValue(hash, node->GetVolume()->GetNumber());
+      HashValue(hash, node->GetNumber());
+    }
+  }
+
+  return hash;
+}
+
+//
+// public methods
+//
+
+//_____________________________________________________________________________
+G4bool TG4GeometryCache::Load()
+{
+  /// Compute the hash of the current Root geometry and load the cache file
+  /// if its hash matches. Return true if the cached data are available.
+  /// The file is read only once, the following calls return the info
+  /// whether the cached mapping is available.
+
+  if (fIsLoaded) return fMediumIds.size() || fHasSDSelection;
+  fIsLoaded = true;
+
+  // The cache key is meaningful only with the Root geometry
+  if (!gGeoManager) return false;
+
+  fHash = ComputeHash(gGeoManager);
+
+  std::ifstream input(fFileName, std::ios::binary);
+  if (!input.is_open()) return false;
+
+  UInt_t magicNumber = 0;
+  UInt_t version = 0;
+  ULong64_t hash = 0;
+  if (!ReadValue(input, magicNumber) || magicNumber != fgkMagicNumber ||
+      !ReadValue(input, version) || version != fgkVersion ||
+      !ReadValue(input, hash) || hash != fHash) {
+    G4cout << "Geometry cache " << fFileName
+           << " does not match the current geometry and will be rebuilt."
+           << G4endl;
+    return false;
+  }
+
+  std::vector<G4int> mediumIds;
+  std::vector<G4String> volumeNames;
+  UInt_t nofMediumIds = 0;
+  G4bool isValid = ReadValue(input, nofMediumIds);
+  if (isValid) {
+    mediumIds.resize(nofMediumIds);
+    volumeNames.resize(nofMediumIds);
+  }
+  for (UInt_t i = 0; isValid && i < nofMediumIds; ++i) {
+    isValid =
+      ReadString(input, volumeNames[i]) && ReadValue(input, mediumIds[i]);
+  }
+
+  G4String label;
+  std::set<G4String> selection;
+  UChar_t hasSDSelection = 0;
+  UInt_t nofSelected = 0;
+  isValid = isValid && ReadValue(input, hasSDSelection) &&
+            ReadString(input, label) && ReadValue(input, nofSelected);
+  for (UInt_t i = 0; isValid && i < nofSelected; ++i) {
+    G4String name;
+    isValid = ReadString(input, name);
+    selection.insert(name);
+  }
+
+  if (!isValid) {
+    TG4Globals::Warning("TG4GeometryCache", "Load",
+      "Cannot read the geometry cache " + TString(fFileName.data()));
+    return false;
+  }
+
+  fMediumIds = mediumIds;
+  fVolumeNames = volumeNames;
+  fHasSDSelection = hasSDSelection;
+  fSDLabel = label;
+  fSDSelection = selection;
+
+  G4cout << "Geometry cache " << fFileName << " loaded." << G4endl;
+  return true;
+}
+
+//_____________________________________________________________________________
+void TG4GeometryCache::Save()
+{
+  /// Write the cached data in the cache file if they were modified
+
+  if (!IsActive() || !fIsModified || !gGeoManager) return;
+
+  if (!fIsLoaded) {
+    fHash = ComputeHash(gGeoManager);
+    fIsLoaded = true;
+  }
+
+  std::ofstream output(fFileName, std::ios::binary | std::ios::trunc);
+  if (!output.is_open()) {
+    TG4Globals::Warning("TG4GeometryCache", "Save",
+      "Cannot open the geometry cache " + TString(fFileName.data()));
+    return;
+  }
+
+  WriteValue(output, fgkMagicNumber);
+  WriteValue(output, fgkVersion);
+  WriteValue(output, fHash);
+
+  WriteValue<UInt_t>(output, fMediumIds.size());
+  for (size_t i = 0; i < fMediumIds.size(); ++i) {
+    WriteString(output, fVolumeNames[i]);
+    WriteValue(output, fMediumIds[i]);
+  }
+
+  WriteValue<UChar_t>(output, fHasSDSelection);
+  WriteString(output, fSDLabel);
+  WriteValue<UInt_t>(output, fSDSelection.size());
+  for (const auto& name : fSDSelection) WriteString(output, name);
+
+  fIsModified = false;
+}
+
+//_____________________________________________________________________________
+void TG4GeometryCache::SetMediumIds(const std::vector<G4int>& mediumIds,
+  const std::vector<G4String>& volumeNames)
+{
+  /// Set the medium Ids per logical volume (-1 if not mapped)
+  /// and the names of these logical volumes
+
+  if (mediumIds.size() != volumeNames.size()) {
+    TG4Globals::Exception("TG4GeometryCache", "SetMediumIds",
+      "The numbers of medium Ids and volume names differ.");
+  }
+
+  fMediumIds = mediumIds;
+  fVolumeNames = volumeNames;
+  fIsModified = true;
+}
+
+//_____________________________________________________________________________
+void TG4GeometryCache::SetSDSelection(
+  const G4String& label, const std::set<G4String>& selection)
+{
+  /// Set the selection of sensitive volumes defined with the given label
+
+  fSDLabel = label;
+  fSDSelection = selection;
+  fHasSDSelection = true;
+  fIsModified = true;
+}
+
+//_____________________________________________________________________________
+G4bool TG4GeometryCache::GetSDSelection(
+  const G4String& label, std::set<G4String>& selection) const
+{
+  /// Fill the selection of sensitive volumes if it is available for
+  /// the given label; return false otherwise
+
+  if (!fHasSDSelection || fSDLabel != label) return false;
+
+  selection = fSDSelection;
+  return true;
+}
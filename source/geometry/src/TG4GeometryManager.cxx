@@ -30,17 +30,20 @@
 #include "TG4OpGeometryManager.h"
 #include "TG4RadiatorDescription.h"
 #include "TG4RootDetectorConstruction.h"
+#include "TG4RootNavigator.h"
 #include "TG4SDManager.h"
 #include "TG4StateManager.h"
 #include "TG4VUserPostDetConstruction.h"
 #include "TG4VUserRegionConstruction.h"
 
+#include <G4AutoLock.hh>
 #include <G4FieldManager.hh>
 #include <G4LogicalVolumeStore.hh>
 #include <G4Material.hh>
 #include <G4MonopoleFieldSetup.hh>
 #include <G4PVPlacement.hh>
 #include <G4ReflectionFactory.hh>
+#include <G4Threading.hh>
 //#include <G4SystemOfUnits.hh>
 #include <G4TransportationManager.hh>
 
@@ -77,6 +80,14 @@ const G4double TG4GeometryManager::fgDefaultMaxStep = 10 * cm;
 
 G4ThreadLocal std::vector<TG4Field*>* TG4GeometryManager::fgFields = 0;
 
+#ifdef G4MULTITHREADED
+namespace
+{
+// Mutex to lock merging field statistics
+G4Mutex mergeFieldStatisticsMutex = G4MUTEX_INITIALIZER;
+} // namespace
+#endif
+
 //_____________________________________________________________________________
 TG4GeometryManager::TG4GeometryManager(const TString& userGeometry)
   : TG4Verbose("geometryManager"),
@@ -90,6 +101,9 @@ TG4GeometryManager::TG4GeometryManager(const TString& userGeometry)
     fBiasingManager(0),
     fUserGeometry(userGeometry),
     fFieldParameters(),
+    fFieldStatistics(),
+    fRadiators(),
+    fGeometryCache(),
     fUserRegionConstruction(0),
     fUserPostDetConstruction(0),
     fIsLocalField(false),
@@ -339,6 +353,48 @@ void TG4GeometryManager::ConstructG4Geometry()
   }
 }
 
+//_____________________________________________________________________________
+G4bool TG4GeometryManager::MapMediaFromCache(TG4MediumMap* mediumMap)
+{
+  /// Map media to logical volumes using the medium Ids from the geometry
+  /// cache; return false if the cached mapping is not available.
+  /// The cache is used only with the Root geometry, as its key is
+  /// the hash of the Root geometry content. The cached medium Ids are
+  /// used only if the cached logical volume names match the volumes
+  /// in G4LogicalVolumeStore, otherwise false is returned and the media
+  /// are mapped in the standard way.
+
+  if (!fGeometryCache.IsActive() || !fGeometryCache.Load()) return false;
+
+  G4LogicalVolumeStore* lvStore = G4LogicalVolumeStore::GetInstance();
+  const std::vector<G4int>& mediumIds = fGeometryCache.GetMediumIds();
+  const std::vector<G4String>& volumeNames = fGeometryCache.GetVolumeNames();
+  if (mediumIds.size() != lvStore->size() ||
+      volumeNames.size() != lvStore->size())
+    return false;
+
+  for (G4int i = 0; i < G4int(lvStore->size()); i++) {
+    if ((*lvStore)[i]->GetName() != volumeNames[i]) {
+      if (VerboseLevel() > 0) {
+        G4cout << "Geometry cache volume " << volumeNames[i]
+               << " does not match LV " << (*lvStore)[i]->GetName()
+               << ", the cached media will not be used." << G4endl;
+      }
+      return false;
+    }
+  }
+
+  for (G4int i = 0; i < G4int(lvStore->size()); i++) {
+    if (mediumIds[i] < 0) continue;
+    mediumMap->MapMedium((*lvStore)[i], mediumIds[i]);
+  }
+
+  if (VerboseLevel() > 1) {
+    G4cout << "Media mapped to logical volumes from geometry cache" << G4endl;
+  }
+  return true;
+}
+
 //_____________________________________________________________________________
 void TG4GeometryManager::FillMediumMapFromG3()
 {
@@ -503,10 +559,16 @@ void TG4GeometryManager::FillMediumMapFromRoot()
     medium->SetMaterial(material);
   }
 
+  // Use the cached mapping if available
+  if (MapMediaFromCache(mediumMap)) return;
+
   // Map media to logical volumes
   G4LogicalVolumeStore* lvStore = G4LogicalVolumeStore::GetInstance();
+  std::vector<G4int> mediumIds(lvStore->size(), -1);
+  std::vector<G4String> volumeNames(lvStore->size());
   for (G4int i = 0; i < G4int(lvStore->size()); i++) {
     G4LogicalVolume* lv = (*lvStore)[i];
+    volumeNames[i] = lv->GetName();
 
     TGeoVolume* geoVolume = nullptr;
 
@@ -544,6 +606,11 @@ void TG4GeometryManager::FillMediumMapFromRoot()
              << G4endl;
     }
     mediumMap->MapMedium(lv, mediumID);
+    mediumIds[i] = mediumID;
+  }
+
+  if (fGeometryCache.IsActive()) {
+    fGeometryCache.SetMediumIds(mediumIds, volumeNames);
   }
 }
 
@@ -582,7 +649,13 @@ void TG4GeometryManager::CreateField(TVirtualMagField* magField,
       fieldType.append(lv->GetName());
       fieldType.append(")");
     }
-    if (isCachedMagneticField) {
+    if (fieldParameters->GetGridType() != kNoGrid) {
+      fieldType.append(" grid (");
+      fieldType.append(
+        TG4FieldParameters::GridTypeName(fieldParameters->GetGridType()));
+      fieldType.append(")");
+    }
+    else if (isCachedMagneticField) {
       fieldType.append(" cached");
     }
 
@@ -839,6 +912,10 @@ void TG4GeometryManager::ConstructSDandField()
   // Initialize SD manager (create SDs)
   TG4SDManager::Instance()->Initialize();
 
+  // Write the geometry cache once both the medium map and
+  // the SD selection are filled
+  if (G4Threading::IsMasterThread()) fGeometryCache.Save();
+
   // Create global field
   ConstructGlobalField();
 
@@ -1017,6 +1094,59 @@ void TG4GeometryManager::SetIsUserMaxStep(G4bool isUserMaxStep)
   fIsUserMaxStep = isUserMaxStep;
 }
 
+//_____________________________________________________________________________
+void TG4GeometryManager::SetNativeNavigation(const G4String& volumeName)
+{
+  /// Select the volume whose subtree will be navigated with the native
+  /// G4Navigator instead of TGeo (with Root navigation only)
+
+  if (!fRootDetectorConstruction) {
+    TG4Globals::Warning("TG4GeometryManager", "SetNativeNavigation",
+      "The native navigation can be selected only with Root navigation." +
+        TG4Globals::Endl() + "The command is ignored.");
+    return;
+  }
+
+  if (VerboseLevel() > 0)
+    G4cout << "TG4GeometryManager::SetNativeNavigation: " << volumeName
+           << G4endl;
+
+  if (!fRootDetectorConstruction->SetNativeNavigation(volumeName.data())) {
+    TG4Globals::Warning("TG4GeometryManager", "SetNativeNavigation",
+      "Root volume " + TString(volumeName.data()) + " not found.");
+  }
+}
+
+//_____________________________________________________________________________
+void TG4GeometryManager::SetZeroStepPolicy(G4int maxZeroSteps, G4double nudge,
+  G4double nudgeFactor, G4double maxNudge)
+{
+  /// Set the policy for tracks stuck with zero steps in Root navigation:
+  /// the number of zero steps before the first nudge, the first nudge step,
+  /// its growth factor and the maximum nudge step
+
+  // The limits of G4PropagatorInField: 50 zero steps, 1.e-4 mm
+  if (maxZeroSteps < 1 || maxZeroSteps >= 50 || nudge <= 1.e-4 * mm ||
+      nudgeFactor < 1. || maxNudge < nudge) {
+    TG4Globals::Warning("TG4GeometryManager", "SetZeroStepPolicy",
+      "Invalid zero step policy parameters." + TG4Globals::Endl() +
+        "The command is ignored.");
+    return;
+  }
+
+  if (VerboseLevel() > 0)
+    G4cout << "TG4GeometryManager::SetZeroStepPolicy: " << maxZeroSteps << " "
+           << nudge / mm << " mm " << nudgeFactor << " " << maxNudge / mm
+           << " mm" << G4endl;
+
+  TG4RootNavigator::ZeroStepPolicy policy;
+  policy.fMaxZeroSteps = maxZeroSteps;
+  policy.fNudge = nudge;
+  policy.fNudgeFactor = nudgeFactor;
+  policy.fMaxNudge = maxNudge;
+  TG4RootNavigator::SetZeroStepPolicy(policy);
+}
+
 //_____________________________________________________________________________
 void TG4GeometryManager::SetIsMaxStepInLowDensityMaterials(G4bool isMaxStep)
 {
@@ -1082,10 +1212,59 @@ void TG4GeometryManager::SetUserStepper(
 }
 
 //_____________________________________________________________________________
-void TG4GeometryManager::PrintFieldStatistics() const
+void TG4GeometryManager::MergeFieldStatistics()
+{
+  /// Add the field statistics collected on this worker to the merged
+  /// statistics and clear the worker counters.
+  /// Called on workers at the end of run.
+
+  if (!fgFields) return;
+
+#ifdef G4MULTITHREADED
+  G4AutoLock lm(&mergeFieldStatisticsMutex);
+#endif
+
+  if (fFieldStatistics.size() < fgFields->size()) {
+    fFieldStatistics.resize(fgFields->size(), std::make_pair(0, 0));
+  }
+
+  for (G4int i = 0; i < G4int(fgFields->size()); ++i) {
+    auto mgfield =
+      dynamic_cast<TG4MagneticField*>(fgFields->at(i)->GetG4Field());
+    G4long nofCalls = 0;
+    G4long nofEvaluations = 0;
+    if (mgfield && mgfield->GetStatistics(nofCalls, nofEvaluations)) {
+      fFieldStatistics[i].first += nofCalls;
+      fFieldStatistics[i].second += nofEvaluations;
+      mgfield->ClearCounter();
+    }
+  }
+}
+
+//_____________________________________________________________________________
+void TG4GeometryManager::PrintFieldStatistics()
 {
   /// Print field statistics.
-  /// Currently only the cached field prints the caching statistics.
+  /// Currently only the cached and grid fields print their statistics.
+  /// In multi-threaded mode, the statistics merged from all workers
+  /// are printed on master and then cleared.
+
+  if (G4Threading::IsMultithreadedApplication() &&
+      G4Threading::IsMasterThread()) {
+    if (VerboseLevel() > 0) {
+      for (G4int i = 0; i < G4int(fFieldStatistics.size()); ++i) {
+        if (!fFieldStatistics[i].first) continue;
+        G4cout << "Field " << i << " (merged from all threads): " << G4endl
+               << "   Number of calls:        " << fFieldStatistics[i].first
+               << G4endl
+               << "   Number of evaluations : " << fFieldStatistics[i].second
+               << G4endl;
+      }
+    }
+    fFieldStatistics.clear();
+    return;
+  }
+
   if (VerboseLevel() > 0 && fgFields) {
     for (G4int i = 0; i < G4int(fgFields->size()); ++i) {
       auto f = fgFields->at(i); // this is a TG4Field
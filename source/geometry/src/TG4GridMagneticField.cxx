@@ -0,0 +1,514 @@
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2026 Geant4 VMC developers
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4GridMagneticField.cxx
+/// \brief Implementation of the TG4GridMagneticField class
+///
+///
+/// \author Geant4 VMC developers
+
+#include "TG4GridMagneticField.h"
+#include "TG4Globals.h"
+#include "TG4StepProfiler.h"
+
+#include <TVirtualMagField.h>
+
+// Moved after Root includes to avoid shadowed variables
+// generated from short units names
+#include <G4PhysicalConstants.hh>
+#include <G4SystemOfUnits.hh>
+
+#include <G4AutoLock.hh>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+const G4long TG4GridMagneticField::fgkMaxNofNodes = 100000000;
+const G4double TG4GridMagneticField::fgkMaxWaitTime = 60.;
+std::map<const TG4FieldParameters*,
+  std::shared_ptr<TG4GridMagneticField::Table>>
+  TG4GridMagneticField::fgTables;
+
+namespace
+{
+/// Wrap the index into [0, n)
+inline G4int WrapIndex(G4int i, G4int n)
+{
+  i %= n;
+  return (i < 0) ? i + n : i;
+}
+
+/// Clamp the index into [0, n)
+inline G4int ClampIndex(G4int i, G4int n)
+{
+  return (i < 0) ? 0 : ((i >= n) ? n - 1 : i);
+}
+
+/// Mutex to lock the access to the shared tables
+G4Mutex tablesMutex = G4MUTEX_INITIALIZER;
+} // namespace
+
+//_____________________________________________________________________________
+TG4GridMagneticField::Table::Table(G4long nofNodes)
+  : fNofNodes(nofNodes),
+    fGrid(),
+    fBlocks(),
+    fNofBlocks((nofNodes + fgkBlockSize - 1) / fgkBlockSize),
+    fNofFilledNodes(0)
+{
+  /// Standard constructor; the blocks are allocated on first access
+
+  fBlocks.reset(new std::atomic<Block*>[fNofBlocks]);
+  for (G4long i = 0; i < fNofBlocks; ++i) fBlocks[i].store(nullptr);
+}
+
+//_____________________________________________________________________________
+TG4GridMagneticField::Table::~Table()
+{
+  /// Destructor
+
+  for (G4long i = 0; i < fNofBlocks; ++i) delete fBlocks[i].load();
+}
+
+//_____________________________________________________________________________
+TG4GridMagneticField::TG4GridMagneticField(
+  TVirtualMagField* magField, const TG4FieldParameters& parameters)
+  : TG4MagneticField(magField, parameters.GetBulkEvaluation()),
+    fGridType(parameters.GetGridType()),
+    fInterpolation(parameters.GetInterpolationType()),
+    fCheckFrequency(parameters.GetGridCheckFrequency()),
+    fTable(),
+    fNodePoints(),
+    fNodeIndices(),
+    fNodeValues(),
+    fWaitIndices(),
+    fCallsCounter(0),
+    fEvaluationsCounter(0),
+    fOutsideCounter(0),
+    fNofFilledNodes(0),
+    fChecksCounter(0),
+    fMaxAbsError(0.),
+    fMaxRelError(0.)
+{
+  /// Standard constructor
+
+  if (fGridType == kNoGrid) {
+    TG4Globals::Exception("TG4GridMagneticField", "TG4GridMagneticField",
+      "The field grid type is not defined.");
+  }
+
+  G4ThreeVector minimum = parameters.GetGridMinimum();
+  G4ThreeVector maximum = parameters.GetGridMaximum();
+  G4double lower[3] = { minimum.x(), minimum.y(), minimum.z() };
+  G4double upper[3] = { maximum.x(), maximum.y(), maximum.z() };
+
+  if (fGridType == kCylindricalGrid) {
+    // (r, phi, z); phi always covers the full circle
+    if (lower[0] < 0.) lower[0] = 0.;
+    lower[1] = -pi;
+    upper[1] = pi;
+  }
+
+  G4long nofNodes = 1;
+  for (G4int i = 0; i < 3; ++i) {
+    fIsPeriodic[i] = (fGridType == kCylindricalGrid && i == 1);
+    fNofBins[i] = parameters.GetGridNofBins(i);
+
+    if (fNofBins[i] < 1 || upper[i] <= lower[i]) {
+      TG4Globals::Exception("TG4GridMagneticField", "TG4GridMagneticField",
+        "The field grid limits or the number of bins are not valid.");
+    }
+
+    fMinimum[i] = lower[i];
+    fSpacing[i] = (upper[i] - lower[i]) / fNofBins[i];
+    fInverseSpacing[i] = 1. / fSpacing[i];
+    fNofNodes[i] = fIsPeriodic[i] ? fNofBins[i] : fNofBins[i] + 1;
+    nofNodes *= fNofNodes[i];
+  }
+
+  if (nofNodes > fgkMaxNofNodes) {
+    TG4Globals::Exception("TG4GridMagneticField", "TG4GridMagneticField",
+      "The field grid has too many nodes (" + std::to_string(nofNodes) +
+        ").");
+  }
+
+  G4double grid[9];
+  for (G4int i = 0; i < 3; ++i) {
+    grid[i] = fMinimum[i];
+    grid[3 + i] = fSpacing[i];
+    grid[6 + i] = fNofNodes[i];
+  }
+
+  // Get the table shared with the fields of other threads
+  // or create a new one if the grid was changed
+  G4AutoLock lock(&tablesMutex);
+  std::shared_ptr<Table>& table = fgTables[&parameters];
+  if (!table || !std::equal(grid, grid + 9, table->fGrid)) {
+    table = std::make_shared<Table>(nofNodes);
+    std::copy(grid, grid + 9, table->fGrid);
+  }
+  fTable = table;
+}
+
+//_____________________________________________________________________________
+TG4GridMagneticField::~TG4GridMagneticField()
+{
+  /// Destructor
+}
+
+//
+// private methods
+//
+
+//_____________________________________________________________________________
+G4bool TG4GridMagneticField::ToGridCoordinates(
+  const G4double point[3], G4double gridPoint[3]) const
+{
+  /// Convert the point to the continuous grid index coordinates;
+  /// return false if the point is outside the grid
+
+  G4double coordinates[3] = { point[0], point[1], point[2] };
+  if (fGridType == kCylindricalGrid) {
+    coordinates[0] = std::sqrt(point[0] * point[0] + point[1] * point[1]);
+    coordinates[1] = std::atan2(point[1], point[0]);
+  }
+
+  for (G4int i = 0; i < 3; ++i) {
+    gridPoint[i] = (coordinates[i] - fMinimum[i]) * fInverseSpacing[i];
+    if (!fIsPeriodic[i] && (gridPoint[i] < 0. || gridPoint[i] > fNofBins[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+//_____________________________________________________________________________
+void TG4GridMagneticField::FillNodes(
+  const G4int indices[3][4], G4int nofPoints) const
+{
+  /// Evaluate the user field in all not yet filled nodes of the
+  /// interpolation stencil in one GetFieldValues() call.
+  /// The nodes being filled by other threads are waited for.
+  /// If the user field throws, the claimed nodes are released (set empty)
+  /// before the exception is rethrown, so that they are not waited for
+  /// forever.
+
+  fNodeIndices.clear();
+  fNodePoints.clear();
+  fWaitIndices.clear();
+
+  for (G4int i = 0; i < nofPoints; ++i) {
+    for (G4int j = 0; j < nofPoints; ++j) {
+      for (G4int k = 0; k < nofPoints; ++k) {
+        G4long index = GetNodeIndex(indices[0][i], indices[1][j], indices[2][k]);
+        std::atomic<unsigned char>& state =
+          GetBlock(index)->fStates[index % fgkBlockSize];
+        if (state.load(std::memory_order_acquire) == kFilledNode) continue;
+
+        // claim the node; this also avoids duplicates (clamped or wrapped
+        // indices) as a node claimed in this call is not empty
+        unsigned char expected = kEmptyNode;
+        if (!state.compare_exchange_strong(
+              expected, kFillingNode, std::memory_order_acq_rel)) {
+          if (expected == kFillingNode) fWaitIndices.push_back(index);
+          continue;
+        }
+        fNodeIndices.push_back(index);
+
+        G4double position[3];
+        GetNodePosition(index, position);
+        fNodePoints.insert(fNodePoints.end(), position, position + 3);
+      }
+    }
+  }
+
+  G4int nofNodes = fNodeIndices.size();
+  if (nofNodes) {
+    fNodeValues.resize(3 * nofNodes);
+    try {
+      TG4MagneticField::GetFieldValues(
+        nofNodes, fNodePoints.data(), fNodeValues.data());
+    }
+    catch (...) {
+      for (auto index : fNodeIndices) {
+        GetBlock(index)->fStates[index % fgkBlockSize].store(
+          kEmptyNode, std::memory_order_release);
+      }
+      throw;
+    }
+
+    for (G4int n = 0; n < nofNodes; ++n) {
+      G4long index = fNodeIndices[n];
+      Block* block = GetBlock(index);
+      G4double* value = &block->fValues[3 * (index % fgkBlockSize)];
+      value[0] = fNodeValues[3 * n];
+      value[1] = fNodeValues[3 * n + 1];
+      value[2] = fNodeValues[3 * n + 2];
+      block->fStates[index % fgkBlockSize].store(
+        kFilledNode, std::memory_order_release);
+    }
+
+    fEvaluationsCounter += nofNodes;
+    fNofFilledNodes += nofNodes;
+    fTable->fNofFilledNodes += nofNodes;
+  }
+
+  // wait for the nodes filled by other threads
+  // (the nodes claimed by this thread are already published)
+  for (auto index : fWaitIndices) {
+    WaitForNode(index);
+  }
+}
+
+//_____________________________________________________________________________
+void TG4GridMagneticField::WaitForNode(G4long index) const
+{
+  /// Wait until the node claimed by another thread is filled.
+  /// If the node was released (the other thread failed), it is claimed and
+  /// evaluated directly. The wait is limited to fgkMaxWaitTime.
+
+  std::atomic<unsigned char>& state =
+    GetBlock(index)->fStates[index % fgkBlockSize];
+  auto start = std::chrono::steady_clock::now();
+
+  while (true) {
+    unsigned char expected = state.load(std::memory_order_acquire);
+    if (expected == kFilledNode) return;
+
+    if (expected == kEmptyNode &&
+        state.compare_exchange_strong(
+          expected, kFillingNode, std::memory_order_acq_rel)) {
+      G4double position[3];
+      G4double value[3];
+      GetNodePosition(index, position);
+      try {
+        TG4MagneticField::GetFieldValues(1, position, value);
+      }
+      catch (...) {
+        state.store(kEmptyNode, std::memory_order_release);
+        throw;
+      }
+      G4double* nodeValue =
+        &GetBlock(index)->fValues[3 * (index % fgkBlockSize)];
+      nodeValue[0] = value[0];
+      nodeValue[1] = value[1];
+      nodeValue[2] = value[2];
+      state.store(kFilledNode, std::memory_order_release);
+
+      ++fEvaluationsCounter;
+      ++fNofFilledNodes;
+      ++fTable->fNofFilledNodes;
+      return;
+    }
+
+    std::chrono::duration<G4double> waitTime =
+      std::chrono::steady_clock::now() - start;
+    if (waitTime.count() > fgkMaxWaitTime) {
+      TG4Globals::Exception("TG4GridMagneticField", "WaitForNode",
+        "The grid node " + std::to_string(index) +
+          " was not filled by another thread in time.");
+    }
+    std::this_thread::yield();
+  }
+}
+
+//_____________________________________________________________________________
+void TG4GridMagneticField::GetNodePosition(
+  G4long index, G4double position[3]) const
+{
+  /// Return the position of the grid node with the given index
+  /// in the global (Cartesian) coordinates
+
+  G4int k = index % fNofNodes[2];
+  G4int j = (index / fNofNodes[2]) % fNofNodes[1];
+  G4int i = index / (G4long(fNofNodes[1]) * fNofNodes[2]);
+
+  position[0] = fMinimum[0] + i * fSpacing[0];
+  position[1] = fMinimum[1] + j * fSpacing[1];
+  position[2] = fMinimum[2] + k * fSpacing[2];
+  if (fGridType == kCylindricalGrid) {
+    G4double r = position[0];
+    position[0] = r * std::cos(position[1]);
+    position[1] = r * std::sin(position[1]);
+  }
+}
+
+//_____________________________________________________________________________
+void TG4GridMagneticField::Interpolate(
+  const G4double gridPoint[3], G4double* bfield) const
+{
+  /// Interpolate the field value from the grid nodes
+
+  G4int nofPoints = (fInterpolation == kCubicInterpolation) ? 4 : 2;
+  G4int indices[3][4];
+  G4double weights[3][4];
+
+  for (G4int axis = 0; axis < 3; ++axis) {
+    G4int i = G4int(std::floor(gridPoint[axis]));
+    if (!fIsPeriodic[axis] && i >= fNofBins[axis]) {
+      // upper edge
+      i = fNofBins[axis] - 1;
+    }
+    G4double t = gridPoint[axis] - i;
+
+    if (fInterpolation == kCubicInterpolation) {
+      // Catmull-Rom weights for nodes i-1, i, i+1, i+2
+      G4double t2 = t * t;
+      G4double t3 = t2 * t;
+      weights[axis][0] = 0.5 * (-t3 + 2. * t2 - t);
+      weights[axis][1] = 0.5 * (3. * t3 - 5. * t2 + 2.);
+      weights[axis][2] = 0.5 * (-3. * t3 + 4. * t2 + t);
+      weights[axis][3] = 0.5 * (t3 - t2);
+      for (G4int n = 0; n < 4; ++n) {
+        indices[axis][n] = fIsPeriodic[axis]
+                             ? WrapIndex(i - 1 + n, fNofNodes[axis])
+                             : ClampIndex(i - 1 + n, fNofNodes[axis]);
+      }
+    }
+    else {
+      weights[axis][0] = 1. - t;
+      weights[axis][1] = t;
+      for (G4int n = 0; n < 2; ++n) {
+        indices[axis][n] = fIsPeriodic[axis]
+                             ? WrapIndex(i + n, fNofNodes[axis])
+                             : ClampIndex(i + n, fNofNodes[axis]);
+      }
+    }
+  }
+
+  FillNodes(indices, nofPoints);
+
+  bfield[0] = 0.;
+  bfield[1] = 0.;
+  bfield[2] = 0.;
+  for (G4int i = 0; i < nofPoints; ++i) {
+    for (G4int j = 0; j < nofPoints; ++j) {
+      G4double wij = weights[0][i] * weights[1][j];
+      for (G4int k = 0; k < nofPoints; ++k) {
+        G4double w = wij * weights[2][k];
+        G4long index = GetNodeIndex(indices[0][i], indices[1][j], indices[2][k]);
+        const G4double* value =
+          &GetBlock(index)->fValues[3 * (index % fgkBlockSize)];
+        bfield[0] += w * value[0];
+        bfield[1] += w * value[1];
+        bfield[2] += w * value[2];
+      }
+    }
+  }
+}
+
+//_____________________________________________________________________________
+void TG4GridMagneticField::CheckValue(
+  const G4double point[3], const G4double* bfield) const
+{
+  /// Compare the interpolated value with the exact field value
+  /// and update the maximum errors
+
+  G4double exact[3];
+  TG4MagneticField::GetFieldValue(point, exact);
+  ++fEvaluationsCounter;
+  ++fChecksCounter;
+
+  G4double diff2 = 0.;
+  G4double exact2 = 0.;
+  for (G4int i = 0; i < 3; ++i) {
+    diff2 += (bfield[i] - exact[i]) * (bfield[i] - exact[i]);
+    exact2 += exact[i] * exact[i];
+  }
+
+  G4double absError = std::sqrt(diff2);
+  if (absError > fMaxAbsError) fMaxAbsError = absError;
+
+  if (exact2 > 0.) {
+    G4double relError = absError / std::sqrt(exact2);
+    if (relError > fMaxRelError) fMaxRelError = relError;
+  }
+}
+
+//
+// public methods
+//
+
+//_____________________________________________________________________________
+void TG4GridMagneticField::GetFieldValue(
+  const G4double point[3], G4double* bfield) const
+{
+  /// Return the bfield values in the given point.
+
+  TG4ProfilerTimer timer(TG4StepProfiler::kField);
+
+  ++fCallsCounter;
+
+  G4double gridPoint[3];
+  if (!ToGridCoordinates(point, gridPoint)) {
+    // Outside the grid: evaluate the user field
+    ++fOutsideCounter;
+    ++fEvaluationsCounter;
+    TG4MagneticField::GetFieldValue(point, bfield);
+    return;
+  }
+
+  Interpolate(gridPoint, bfield);
+
+  if (fCheckFrequency > 0 && fCallsCounter % fCheckFrequency == 0) {
+    CheckValue(point, bfield);
+  }
+}
+
+//_____________________________________________________________________________
+void TG4GridMagneticField::GetFieldValues(
+  G4int nofPoints, const G4double* points, G4double* bfields) const
+{
+  /// Return the bfield values interpolated from the grid in the given points;
+  /// the points and the field values are stored as (x0,y0,z0,x1,...).
+
+  for (G4int i = 0; i < nofPoints; ++i) {
+    GetFieldValue(points + 3 * i, bfields + 3 * i);
+  }
+}
+
+//_____________________________________________________________________________
+void TG4GridMagneticField::PrintStatistics() const
+{
+  /// Print the grid statistics
+
+  G4cout << "TG4GridMagneticField: " << G4endl
+         << "   Grid type:              "
+         << TG4FieldParameters::GridTypeName(fGridType) << " ("
+         << TG4FieldParameters::InterpolationTypeName(fInterpolation) << ")"
+         << G4endl
+         << "   Number of calls:        " << fCallsCounter << G4endl
+         << "   Number of evaluations : " << fEvaluationsCounter << G4endl
+         << "   Calls outside grid:     " << fOutsideCounter << G4endl
+         << "   Filled nodes:           " << fNofFilledNodes
+         << " (shared table: " << fTable->fNofFilledNodes << " of "
+         << fTable->fNofNodes << ")" << G4endl;
+
+  if (fChecksCounter > 0) {
+    G4cout << "   Number of checks:       " << fChecksCounter << G4endl
+           << "   Max abs. error:         " << fMaxAbsError / tesla << " T"
+           << G4endl
+           << "   Max rel. error:         " << fMaxRelError << G4endl;
+  }
+}
+
+//_____________________________________________________________________________
+void TG4GridMagneticField::ClearCounter()
+{
+  /// Clear counters (the tabulated values are kept)
+
+  fCallsCounter = 0;
+  fEvaluationsCounter = 0;
+  fOutsideCounter = 0;
+  fChecksCounter = 0;
+  fMaxAbsError = 0.;
+  fMaxRelError = 0.;
+}
@@ -14,14 +14,30 @@
 
 #include "TG4MagneticField.h"
 #include "TG4G3Units.h"
+#include "TG4Globals.h"
+#include "TG4StepProfiler.h"
+#include "TG4VUserBulkMagField.h"
 
 #include <TVirtualMagField.h>
 
 //_____________________________________________________________________________
-TG4MagneticField::TG4MagneticField(TVirtualMagField* magField)
-  : G4MagneticField(), fVirtualMagField(magField)
+TG4MagneticField::TG4MagneticField(
+  TVirtualMagField* magField, G4bool bulkEvaluation)
+  : G4MagneticField(),
+    fVirtualMagField(magField),
+    fBulkMagField(0),
+    fPointsBuffer()
 {
   /// Default constructor
+
+  if (bulkEvaluation) {
+    fBulkMagField = dynamic_cast<TG4VUserBulkMagField*>(magField);
+    if (!fBulkMagField) {
+      TG4Globals::Warning("TG4MagneticField", "TG4MagneticField",
+        "The user field does not implement TG4VUserBulkMagField." +
+          TG4Globals::Endl() + "The bulk evaluation will not be applied.");
+    }
+  }
 }
 
 //_____________________________________________________________________________
@@ -40,6 +56,8 @@ void TG4MagneticField::GetFieldValue(
 {
   /// Return the bfield values in the given point.
 
+  TG4ProfilerTimer timer(TG4StepProfiler::kField);
+
   // Set units
   const G4double g3point[3] = { point[0] * TG4G3Units::InverseLength(),
     point[1] * TG4G3Units::InverseLength(), point[2] * TG4G3Units::InverseLength() };
@@ -50,3 +68,34 @@ void TG4MagneticField::GetFieldValue(
   // Set units
   for (G4int i = 0; i < 3; i++) bfield[i] = bfield[i] * TG4G3Units::Field();
 }
+
+//_____________________________________________________________________________
+void TG4MagneticField::GetFieldValues(
+  G4int nofPoints, const G4double* points, G4double* bfields) const
+{
+  /// Return the bfield values in the given points;
+  /// the points and the field values are stored as (x0,y0,z0,x1,...).
+
+  const G4int size = 3 * nofPoints;
+  const G4double inverseLength = TG4G3Units::InverseLength();
+  const G4double fieldUnit = TG4G3Units::Field();
+
+  if (fBulkMagField) {
+    // Set units in one pass and call the user field once
+    if (G4int(fPointsBuffer.size()) < size) fPointsBuffer.resize(size);
+    G4double* g3points = fPointsBuffer.data();
+    for (G4int i = 0; i < size; ++i) g3points[i] = points[i] * inverseLength;
+
+    fBulkMagField->Field(nofPoints, g3points, bfields);
+  }
+  else {
+    for (G4int i = 0; i < nofPoints; ++i) {
+      const G4double g3point[3] = { points[3 * i] * inverseLength,
+        points[3 * i + 1] * inverseLength, points[3 * i + 2] * inverseLength };
+      fVirtualMagField->Field(g3point, bfields + 3 * i);
+    }
+  }
+
+  // Set units
+  for (G4int i = 0; i < size; ++i) bfields[i] *= fieldUnit;
+}
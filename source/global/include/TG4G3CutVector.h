@@ -62,6 +62,8 @@ class TG4G3CutVector
   G4double GetMinEkineForMuon(const G4Track& track) const;
   G4double GetMinEtotPair() const;
   G4bool IsCut() const;
+  G4bool IsFirstStepCutForGamma() const;
+  G4bool IsFirstStepCutForElectron() const;
 
  private:
   // static methods
@@ -131,4 +133,18 @@ inline G4bool TG4G3CutVector::IsCut() const
   return fIsCut;
 }
 
+inline G4bool TG4G3CutVector::IsFirstStepCutForGamma() const
+{
+  /// Return true if the gamma cut in the track first step can differ
+  /// from CUTGAM (BCUTE, BCUTM)
+  return fApplyBDCut[kB];
+}
+
+inline G4bool TG4G3CutVector::IsFirstStepCutForElectron() const
+{
+  /// Return true if the e- cut in the track first step can differ
+  /// from CUTELE (DCUTE, DCUTM or delta rays switched off)
+  return !fDeltaRaysOn || fApplyBDCut[kD];
+}
+
 #endif // TG4_CUT_VECTOR_H
@@ -32,11 +32,48 @@ class G4VProcess;
 /// vectors of kinetic energy cuts and control process flags
 /// data members.
 ///
+/// The cuts applied by the special cuts process are also compiled
+/// in a compact record per particle class (see ParticleCuts) with the
+/// flags of the checks which have to be performed, so that the process
+/// can skip the checks which are not set. The records are compiled
+/// when the limits are set to the logical volumes and they are updated
+/// with each change of cuts via this class.
+///
 /// \author I. Hrivnacova; IPN, Orsay
 
 class TG4Limits : public G4UserLimits
 {
  public:
+  /// The particle classes with specific kinetic energy cuts
+  enum EParticleClass
+  {
+    kGammaCuts,         ///< gamma (CUTGAM, BCUTE, BCUTM)
+    kElectronCuts,      ///< e-, e+ (CUTELE, DCUTE, DCUTM)
+    kChargedHadronCuts, ///< charged hadrons (CUTHAD)
+    kNeutralHadronCuts, ///< neutral hadrons, neutrons (CUTNEU)
+    kMuonCuts,          ///< muons (CUTMUO)
+    kNofParticleCuts    ///< number of particle classes
+  };
+
+  /// The checks performed by the special cuts process
+  enum ECheck
+  {
+    kFirstStepCheck = 1,      ///< creator dependent cut in the first step
+    kMaxTrackLengthCheck = 2, ///< max track length
+    kMaxTimeCheck = 4,        ///< max time
+    kMinRangeCheck = 8        ///< min remaining range
+  };
+
+  /// The cuts compiled for a particle class (in G4 internal units)
+  struct ParticleCuts
+  {
+    G4double fMinEkine = 0.;            ///< min kinetic energy
+    G4double fMaxTrackLength = DBL_MAX; ///< max track length
+    G4double fMaxTime = DBL_MAX;        ///< max global time
+    G4double fMinRange = 0.;            ///< min remaining range
+    G4int fChecks = 0;                  ///< the checks to be done (ECheck)
+  };
+
   TG4Limits(const TG4G3CutVector& cuts, const TG4G3ControlVector& controls);
   TG4Limits(const G4String& name, const TG4G3CutVector& cuts,
     const TG4G3ControlVector& controls);
@@ -61,8 +98,13 @@ class TG4Limits : public G4UserLimits
   void SetCurrentMaxAllowedStep(G4double step);
   void SetDefaultMaxAllowedStep();
   void SetMaxAllowedStepBack();
+  virtual void SetUserMaxTrackLength(G4double maxTrackLength);
+  virtual void SetUserMaxTime(G4double maxTime);
+  virtual void SetUserMinEkine(G4double minEkine);
+  virtual void SetUserMinRange(G4double minRange);
 
   // methods
+  void CompileParticleCuts();
   void Print() const;
 
   // get methods
@@ -79,6 +121,7 @@ class TG4Limits : public G4UserLimits
   G4double GetMinEkineForNeutralHadron(const G4Track& track) const;
   G4double GetMinEkineForMuon(const G4Track& track) const;
   TG4G3ControlValue GetControl(G4VProcess* process) const;
+  const ParticleCuts& GetParticleCuts(EParticleClass particleClass) const;
 
  private:
   /// Not implemented
@@ -98,6 +141,8 @@ class TG4Limits : public G4UserLimits
   TG4G3CutVector fCutVector;         ///< the vector of G3 cut values
   TG4G3ControlVector fControlVector; ///< the vector of G3 control values
   G4double fDefaultMaxStep;          ///< the default max step value
+  /// the compiled cuts per particle class
+  ParticleCuts fParticleCuts[kNofParticleCuts];
 };
 
 // inline methods
@@ -150,4 +195,11 @@ inline const TG4G3ControlVector* TG4Limits::GetControlVector() const
   return &fControlVector;
 }
 
+inline const TG4Limits::ParticleCuts& TG4Limits::GetParticleCuts(
+  EParticleClass particleClass) const
+{
+  /// Return the compiled cuts for the given particle class
+  return fParticleCuts[particleClass];
+}
+
 #endif // TG4_USER_LIMITS_H
@@ -22,6 +22,7 @@
 #include <TMCProcess.h>
 
 #include <map>
+#include <vector>
 
 class G4VProcess;
 
@@ -31,6 +32,9 @@ class G4VProcess;
 /// Singleton map container for associated pairs
 /// of G4 process sub types and TMCProcess and TG4G3Control code.
 ///
+/// The codes are also stored in a dense table indexed by the process
+/// sub type, which is used for the lookup in GetCodes().
+///
 /// \author I. Hrivnacova; IJClab Orsay
 
 class TG4ProcessMap
@@ -65,6 +69,12 @@ class TG4ProcessMap
 
   // data members
   std::map<G4int, std::pair<TMCProcess, TG4G3Control>> fMap; ///< map container
+
+  /// The codes table indexed by the process sub type
+  std::vector<std::pair<TMCProcess, TG4G3Control>> fTable;
+
+  /// The info whether the codes are defined, indexed by the process sub type
+  std::vector<G4bool> fIsDefinedTable;
 };
 
 // inline methods
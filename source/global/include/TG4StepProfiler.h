@@ -0,0 +1,315 @@
+#ifndef TG4_STEP_PROFILER_H
+#define TG4_STEP_PROFILER_H
+
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2026 Geant4 VMC developers
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4StepProfiler.h
+/// \brief Definition of the TG4StepProfiler and TG4ProfilerTimer classes
+///
+/// \author Geant4 VMC developers
+
+#include <globals.hh>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+class G4Step;
+class G4LogicalVolume;
+class G4ParticleDefinition;
+class G4VProcess;
+
+/// \ingroup global
+/// \brief The per-step cost profiler
+///
+/// When activated via /mcTracking/profile, the time of each step
+/// (measured from the end of the previous stepping action or from the track
+/// start to the start of the current stepping action) and the number of steps
+/// are accumulated in the tables per logical volume, particle and creator
+/// process. The time spent in the instrumented components (stepping action,
+/// sensitive detectors, field evaluation and stack popper) is accumulated
+/// separately; the component times are inclusive (e.g. the stepping action
+/// time includes the sensitive detector call on boundary).
+///
+/// The tables are collected per thread and merged in Merge() at the end of
+/// run; the merged report with the top-N entries is printed by
+/// PrintReport() and written in a CSV file, if its name is set.
+///
+/// \author Geant4 VMC developers
+
+class TG4StepProfiler
+{
+ public:
+  /// The instrumented components
+  enum EComponent
+  {
+    kSteppingAction,    ///< TG4SteppingAction::UserSteppingAction
+    kSensitiveDetector, ///< TG4SensitiveDetector::ProcessHits
+    kField,             ///< TG4MagneticField::GetFieldValue
+    kStackPopper,       ///< TG4StackPopper::PostStepDoIt
+    kNofComponents      ///< number of components
+  };
+
+  /// The accumulated number of steps (calls) and time
+  struct Entry
+  {
+    G4long fNofSteps = 0; ///< the number of steps (calls)
+    G4double fTime = 0.;  ///< the time (in seconds)
+  };
+
+  TG4StepProfiler();
+  ~TG4StepProfiler();
+
+  // static access method
+  static TG4StepProfiler* Instance();
+
+  // static methods
+  static G4String ComponentName(EComponent component);
+  static void PrintReport();
+  static G4bool IsAnyActive();
+
+  // methods
+  void StartTrack();
+  void StartStep(const G4Step* step);
+  void EndStep();
+  void StartComponent(EComponent component);
+  void StopComponent(EComponent component);
+  void Merge();
+
+  // set methods
+  void SetIsActive(G4bool isActive);
+  void SetNofTopEntries(G4int nofTopEntries);
+  void SetFileName(const G4String& fileName);
+
+  // get methods
+  G4bool IsActive() const;
+  G4int GetNofTopEntries() const;
+  const G4String& GetFileName() const;
+
+ private:
+  /// Not implemented
+  TG4StepProfiler(const TG4StepProfiler& right);
+  /// Not implemented
+  TG4StepProfiler& operator=(const TG4StepProfiler& right);
+
+  /// The clock type
+  using Clock = std::chrono::steady_clock;
+
+  // static methods
+  static void PrintTable(const G4String& title,
+    const std::map<G4String, Entry>& table, G4int nofTopEntries,
+    std::ostream* csvOutput);
+
+  // methods
+  void Clear();
+
+  // static data members
+  static G4ThreadLocal TG4StepProfiler* fgInstance; ///< this instance
+  /// The info whether profiling was activated in any thread
+  static std::atomic<G4bool> fgIsAnyActive;
+
+  /// The merged volume table
+  static std::map<G4String, Entry> fgVolumeTable;
+  /// The merged particle table
+  static std::map<G4String, Entry> fgParticleTable;
+  /// The merged creator process table
+  static std::map<G4String, Entry> fgProcessTable;
+  /// The merged components table
+  static std::map<G4String, Entry> fgComponentTable;
+  /// The number of top entries in the merged report
+  static G4int fgNofTopEntries;
+  /// The CSV file name for the merged report
+  static G4String fgFileName;
+
+  // data members
+  /// The info whether profiling is active
+  G4bool fIsActive;
+  /// The number of top entries printed in the report
+  G4int fNofTopEntries;
+  /// The CSV file name (no file is written if empty)
+  G4String fFileName;
+
+  /// The time of the last step mark
+  Clock::time_point fLastMark;
+  /// The info whether the last step mark is valid
+  G4bool fHasLastMark;
+
+  /// The volume table
+  std::unordered_map<const G4LogicalVolume*, Entry> fVolumeTable;
+  /// The particle table
+  std::unordered_map<const G4ParticleDefinition*, Entry> fParticleTable;
+  /// The creator process table (0 = primary)
+  std::unordered_map<const G4VProcess*, Entry> fProcessTable;
+
+  /// The cached particle
+  const G4ParticleDefinition* fCurrentParticle;
+  /// The cached particle entry
+  Entry* fCurrentParticleEntry;
+  /// The cached creator process
+  const G4VProcess* fCurrentProcess;
+  /// The cached creator process entry
+  Entry* fCurrentProcessEntry;
+  /// The cached logical volume
+  const G4LogicalVolume* fCurrentVolume;
+  /// The cached volume entry
+  Entry* fCurrentVolumeEntry;
+
+  /// The component entries
+  Entry fComponents[kNofComponents];
+  /// The component start times
+  Clock::time_point fComponentStart[kNofComponents];
+  /// The component nesting depths
+  G4int fComponentDepth[kNofComponents];
+};
+
+/// \ingroup global
+/// \brief The scoped timer of a profiled component
+///
+/// Starts the component in the constructor and stops it in the destructor,
+/// if the profiler is active. The thread-local profiler is looked up only
+/// if profiling was activated in any thread.
+///
+/// \author Geant4 VMC developers
+
+class TG4ProfilerTimer
+{
+ public:
+  TG4ProfilerTimer(TG4StepProfiler::EComponent component);
+  ~TG4ProfilerTimer();
+
+ private:
+  /// Not implemented
+  TG4ProfilerTimer();
+  /// Not implemented
+  TG4ProfilerTimer(const TG4ProfilerTimer& right);
+  /// Not implemented
+  TG4ProfilerTimer& operator=(const TG4ProfilerTimer& right);
+
+  // data members
+  /// The active profiler (0 if profiling is not active)
+  TG4StepProfiler* fProfiler;
+  /// The profiled component
+  TG4StepProfiler::EComponent fComponent;
+};
+
+// inline functions
+
+inline TG4StepProfiler* TG4StepProfiler::Instance()
+{
+  /// Return this instance
+  return fgInstance;
+}
+
+inline G4bool TG4StepProfiler::IsAnyActive()
+{
+  /// Return the info whether profiling was activated in any thread
+
+  return fgIsAnyActive.load(std::memory_order_relaxed);
+}
+
+inline void TG4StepProfiler::SetIsActive(G4bool isActive)
+{
+  /// (In)Activate profiling
+  fIsActive = isActive;
+  fHasLastMark = false;
+  if (isActive) fgIsAnyActive.store(true, std::memory_order_relaxed);
+}
+
+inline void TG4StepProfiler::SetNofTopEntries(G4int nofTopEntries)
+{
+  /// Set the number of top entries printed in the report
+  fNofTopEntries = nofTopEntries;
+}
+
+inline void TG4StepProfiler::SetFileName(const G4String& fileName)
+{
+  /// Set the CSV file name (no file is written if empty)
+  fFileName = fileName;
+}
+
+inline G4bool TG4StepProfiler::IsActive() const
+{
+  /// Return the info whether profiling is active
+  return fIsActive;
+}
+
+inline G4int TG4StepProfiler::GetNofTopEntries() const
+{
+  /// Return the number of top entries printed in the report
+  return fNofTopEntries;
+}
+
+inline const G4String& TG4StepProfiler::GetFileName() const
+{
+  /// Return the CSV file name
+  return fFileName;
+}
+
+inline void TG4StepProfiler::StartTrack()
+{
+  /// Set the step mark at the track start
+
+  fLastMark = Clock::now();
+  fHasLastMark = true;
+}
+
+inline void TG4StepProfiler::EndStep()
+{
+  /// Set the step mark at the end of the stepping action
+
+  fLastMark = Clock::now();
+  fHasLastMark = true;
+}
+
+inline void TG4StepProfiler::StartComponent(EComponent component)
+{
+  /// Start the component timer (nested calls are not counted)
+
+  if (fComponentDepth[component]++ == 0) {
+    fComponentStart[component] = Clock::now();
+  }
+}
+
+inline void TG4StepProfiler::StopComponent(EComponent component)
+{
+  /// Stop the component timer and accumulate the time
+
+  if (fComponentDepth[component] == 0 || --fComponentDepth[component] > 0)
+    return;
+
+  std::chrono::duration<G4double> time =
+    Clock::now() - fComponentStart[component];
+  ++fComponents[component].fNofSteps;
+  fComponents[component].fTime += time.count();
+}
+
+inline TG4ProfilerTimer::TG4ProfilerTimer(
+  TG4StepProfiler::EComponent component)
+  : fProfiler(0), fComponent(component)
+{
+  /// Standard constructor
+
+  if (!TG4StepProfiler::IsAnyActive()) return;
+
+  fProfiler = TG4StepProfiler::Instance();
+  if (fProfiler && !fProfiler->IsActive()) fProfiler = 0;
+  if (fProfiler) fProfiler->StartComponent(fComponent);
+}
+
+inline TG4ProfilerTimer::~TG4ProfilerTimer()
+{
+  /// Destructor
+
+  if (fProfiler) fProfiler->StopComponent(fComponent);
+}
+
+#endif // TG4_STEP_PROFILER_H
@@ -102,6 +102,8 @@ TG4Limits::TG4Limits(const TG4Limits& right)
 {
   /// Copy constructor
 
+  CompileParticleCuts();
+
   ++fgCounter;
 }
 
@@ -132,6 +134,8 @@ TG4Limits& TG4Limits::operator=(const TG4Limits& right)
   fCutVector = right.fCutVector;
   fControlVector = right.fControlVector;
 
+  CompileParticleCuts();
+
   return *this;
 }
 
@@ -153,6 +157,8 @@ void TG4Limits::Initialize(
   fIsCut = fCutVector.IsCut();
   fIsControl = fControlVector.IsControl();
 
+  CompileParticleCuts();
+
   ++fgCounter;
 }
 
@@ -170,6 +176,43 @@ G4double TG4Limits::GetUserMinEkine(const G4Track& /*track*/)
   return fMinEkine;
 }
 
+//_____________________________________________________________________________
+void TG4Limits::SetUserMaxTrackLength(G4double maxTrackLength)
+{
+  /// Set the max track length in the base class and update the compiled cuts
+
+  G4UserLimits::SetUserMaxTrackLength(maxTrackLength);
+  CompileParticleCuts();
+}
+
+//_____________________________________________________________________________
+void TG4Limits::SetUserMaxTime(G4double maxTime)
+{
+  /// Set the max time in the base class and update the compiled cuts
+
+  G4UserLimits::SetUserMaxTime(maxTime);
+  CompileParticleCuts();
+}
+
+//_____________________________________________________________________________
+void TG4Limits::SetUserMinEkine(G4double minEkine)
+{
+  /// Set the min kinetic energy in the base class and update the compiled
+  /// cuts
+
+  G4UserLimits::SetUserMinEkine(minEkine);
+  CompileParticleCuts();
+}
+
+//_____________________________________________________________________________
+void TG4Limits::SetUserMinRange(G4double minRange)
+{
+  /// Set the min range in the base class and update the compiled cuts
+
+  G4UserLimits::SetUserMinRange(minRange);
+  CompileParticleCuts();
+}
+
 //_____________________________________________________________________________
 void TG4Limits::SetG3Cut(TG4G3Cut cut, G4double cutValue)
 {
@@ -179,6 +222,8 @@ void TG4Limits::SetG3Cut(TG4G3Cut cut, G4double cutValue)
   fIsCut = true;
 
   if (cut == kTOFMAX) fMaxTime = cutValue;
+
+  CompileParticleCuts();
 }
 
 //_____________________________________________________________________________
@@ -190,6 +235,9 @@ void TG4Limits::SetG3Control(
   G4bool result = fControlVector.SetControl(control, controlValue, fCutVector);
 
   if (result) fIsControl = true;
+
+  // the delta rays control is applied also in the cut vector
+  CompileParticleCuts();
 }
 
 //_____________________________________________________________________________
@@ -199,6 +247,8 @@ void TG4Limits::SetG3DefaultCuts()
 
   fCutVector.SetG3Defaults();
   fIsCut = true;
+
+  CompileParticleCuts();
 }
 
 //_____________________________________________________________________________
@@ -261,6 +311,44 @@ void TG4Limits::SetMaxAllowedStepBack()
   fMaxStep = fDefaultMaxStep;
 }
 
+//_____________________________________________________________________________
+void TG4Limits::CompileParticleCuts()
+{
+  /// Compile the cuts applied by the special cuts process per particle
+  /// class. The min kinetic energy is the cut applied in all steps but the
+  /// first one; the creator dependent cuts in the track first step
+  /// (BCUTE, BCUTM, DCUTE, DCUTM) are only flagged with kFirstStepCheck
+  /// and they are then evaluated via the cut vector.
+
+  G4int checks = 0;
+  if (fMaxTrack < DBL_MAX) checks |= kMaxTrackLengthCheck;
+  if (fMaxTime < DBL_MAX) checks |= kMaxTimeCheck;
+  if (fMinRange > DBL_MIN) checks |= kMinRangeCheck;
+
+  for (G4int i = 0; i < kNofParticleCuts; ++i) {
+    fParticleCuts[i].fMinEkine = fMinEkine;
+    fParticleCuts[i].fMaxTrackLength = fMaxTrack;
+    fParticleCuts[i].fMaxTime = fMaxTime;
+    fParticleCuts[i].fMinRange = fMinRange;
+    fParticleCuts[i].fChecks = checks;
+  }
+
+  if (!fIsCut) return;
+
+  fParticleCuts[kGammaCuts].fMinEkine = fCutVector[kCUTGAM];
+  fParticleCuts[kElectronCuts].fMinEkine = fCutVector[kCUTELE];
+  fParticleCuts[kChargedHadronCuts].fMinEkine = fCutVector[kCUTHAD];
+  fParticleCuts[kNeutralHadronCuts].fMinEkine = fCutVector[kCUTNEU];
+  fParticleCuts[kMuonCuts].fMinEkine = fCutVector[kCUTMUO];
+
+  if (fCutVector.IsFirstStepCutForGamma()) {
+    fParticleCuts[kGammaCuts].fChecks |= kFirstStepCheck;
+  }
+  if (fCutVector.IsFirstStepCutForElectron()) {
+    fParticleCuts[kElectronCuts].fChecks |= kFirstStepCheck;
+  }
+}
+
 //_____________________________________________________________________________
 void TG4Limits::Print() const
 {
@@ -23,7 +23,7 @@
 TG4ProcessMap* TG4ProcessMap::fgInstance = 0;
 
 //_____________________________________________________________________________
-TG4ProcessMap::TG4ProcessMap() : fMap()
+TG4ProcessMap::TG4ProcessMap() : fMap(), fTable(), fIsDefinedTable()
 {
   /// Default constructor
 
@@ -72,6 +72,16 @@ G4bool TG4ProcessMap::Add(
     // insert into map
     // only in case it is not yet here
     fMap[subType] = std::pair(mcProcess, g3Control);
+
+    // fill the dense table
+    if (subType >= 0) {
+      if (subType >= G4int(fTable.size())) {
+        fTable.resize(subType + 1, { kPNoProcess, kNoG3Controls });
+        fIsDefinedTable.resize(subType + 1, false);
+      }
+      fTable[subType] = std::pair(mcProcess, g3Control);
+      fIsDefinedTable[subType] = true;
+    }
     return true;
   }
   return false;
@@ -101,6 +111,8 @@ void TG4ProcessMap::Clear()
   /// Clear the map.
 
   fMap.clear();
+  fTable.clear();
+  fIsDefinedTable.clear();
 }
 
 //_____________________________________________________________________________
@@ -112,7 +124,13 @@ TG4ProcessMap::GetCodes(const G4VProcess* process) const
 
   if (!process) return { kPNoProcess, kNoG3Controls };
 
-  auto i = fMap.find(process->GetProcessSubType());
+  G4int subType = process->GetProcessSubType();
+  if (subType >= 0 && subType < G4int(fTable.size()) &&
+      fIsDefinedTable[subType]) {
+    return fTable[subType];
+  }
+
+  auto i = fMap.find(subType);
   if (i == fMap.end()) {
     G4String text = "Unknown process code for ";
     text += process->GetProcessName();
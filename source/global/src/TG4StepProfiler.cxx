@@ -0,0 +1,312 @@
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2026 Geant4 VMC developers
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4StepProfiler.cxx
+/// \brief Implementation of the TG4StepProfiler class
+///
+/// \author Geant4 VMC developers
+
+#include "TG4StepProfiler.h"
+#include "TG4Globals.h"
+
+#include <G4AutoLock.hh>
+#include <G4LogicalVolume.hh>
+#include <G4ParticleDefinition.hh>
+#include <G4Step.hh>
+#include <G4Track.hh>
+#include <G4VPhysicalVolume.hh>
+#include <G4VProcess.hh>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+#ifdef G4MULTITHREADED
+namespace
+{
+// Mutex to lock merging profiler tables
+G4Mutex mergeProfilerMutex = G4MUTEX_INITIALIZER;
+} // namespace
+#endif
+
+// static data members
+G4ThreadLocal TG4StepProfiler* TG4StepProfiler::fgInstance = 0;
+std::atomic<G4bool> TG4StepProfiler::fgIsAnyActive(false);
+std::map<G4String, TG4StepProfiler::Entry> TG4StepProfiler::fgVolumeTable;
+std::map<G4String, TG4StepProfiler::Entry> TG4StepProfiler::fgParticleTable;
+std::map<G4String, TG4StepProfiler::Entry> TG4StepProfiler::fgProcessTable;
+std::map<G4String, TG4StepProfiler::Entry> TG4StepProfiler::fgComponentTable;
+G4int TG4StepProfiler::fgNofTopEntries = 0;
+G4String TG4StepProfiler::fgFileName;
+
+//_____________________________________________________________________________
+TG4StepProfiler::TG4StepProfiler()
+  : fIsActive(false),
+    fNofTopEntries(20),
+    fFileName(),
+    fLastMark(),
+    fHasLastMark(false),
+    fVolumeTable(),
+    fParticleTable(),
+    fProcessTable(),
+    fCurrentParticle(0),
+    fCurrentParticleEntry(0),
+    fCurrentProcess(0),
+    fCurrentProcessEntry(0),
+    fCurrentVolume(0),
+    fCurrentVolumeEntry(0)
+{
+  /// Default constructor
+
+  if (fgInstance) {
+    TG4Globals::Exception("TG4StepProfiler", "TG4StepProfiler",
+      "Cannot create two instances of singleton.");
+  }
+
+  for (G4int i = 0; i < kNofComponents; ++i) fComponentDepth[i] = 0;
+
+  fgInstance = this;
+}
+
+//_____________________________________________________________________________
+TG4StepProfiler::~TG4StepProfiler()
+{
+  /// Destructor
+
+  fgInstance = 0;
+}
+
+//
+// static private methods
+//
+
+//_____________________________________________________________________________
+void TG4StepProfiler::PrintTable(const G4String& title,
+  const std::map<G4String, Entry>& table, G4int nofTopEntries,
+  std::ostream* csvOutput)
+{
+  /// Print the top entries of the table sorted by time
+  /// and write all entries in the CSV output (if provided)
+
+  std::vector<std::pair<G4String, Entry>> entries(table.begin(), table.end());
+  std::sort(entries.begin(), entries.end(),
+    [](const std::pair<G4String, Entry>& a,
+      const std::pair<G4String, Entry>& b) {
+      return a.second.fTime > b.second.fTime;
+    });
+
+  G4double totalTime = 0.;
+  for (const auto& entry : entries) totalTime += entry.second.fTime;
+
+  G4cout << "--- " << title << " (top " << nofTopEntries << " of "
+         << entries.size() << ")" << G4endl;
+  G4cout << std::setw(32) << "name" << std::setw(14) << "steps"
+         << std::setw(14) << "time [s]" << std::setw(10) << "[%]"
+         << std::setw(14) << "time/step [us]" << G4endl;
+
+  G4int counter = 0;
+  for (const auto& entry : entries) {
+    if (counter++ == nofTopEntries) break;
+    G4double fraction =
+      (totalTime > 0.) ? 100. * entry.second.fTime / totalTime : 0.;
+    G4double timePerStep = (entry.second.fNofSteps > 0)
+                             ? 1.e6 * entry.second.fTime / entry.second.fNofSteps
+                             : 0.;
+    G4cout << std::setw(32) << entry.first << std::setw(14)
+           << entry.second.fNofSteps << std::setw(14) << entry.second.fTime
+           << std::setw(10) << std::setprecision(3) << fraction
+           << std::setw(14) << timePerStep << std::setprecision(6) << G4endl;
+  }
+
+  if (csvOutput) {
+    for (const auto& entry : entries) {
+      (*csvOutput) << title << "," << entry.first << ","
+                   << entry.second.fNofSteps << "," << entry.second.fTime
+                   << std::endl;
+    }
+  }
+}
+
+//
+// static public methods
+//
+
+//_____________________________________________________________________________
+G4String TG4StepProfiler::ComponentName(EComponent component)
+{
+  /// Return the component name
+
+  switch (component) {
+    case kSteppingAction:
+      return G4String("SteppingAction");
+    case kSensitiveDetector:
+      return G4String("SensitiveDetector");
+    case kField:
+      return G4String("Field");
+    case kStackPopper:
+      return G4String("StackPopper");
+    case kNofComponents:
+      break;
+  }
+
+  TG4Globals::Exception(
+    "TG4StepProfiler", "ComponentName:", "Unknown component value.");
+  return G4String();
+}
+
+//_____________________________________________________________________________
+void TG4StepProfiler::PrintReport()
+{
+  /// Print the merged tables, write them in the CSV file (if its name is set)
+  /// and clear them.
+  /// Called on master (or in sequential mode) at the end of run.
+
+  if (fgComponentTable.empty() && fgVolumeTable.empty()) return;
+
+  std::ofstream csvFile;
+  std::ostream* csvOutput = 0;
+  if (fgFileName.size()) {
+    csvFile.open(fgFileName);
+    if (csvFile.is_open()) {
+      csvFile << "table,name,steps,time" << std::endl;
+      csvOutput = &csvFile;
+    }
+    else {
+      TG4Globals::Warning("TG4StepProfiler", "PrintReport",
+        "Cannot open the file " + TString(fgFileName.data()));
+    }
+  }
+
+  G4cout << "======= TG4StepProfiler report =======" << G4endl;
+  PrintTable("Components", fgComponentTable, kNofComponents, csvOutput);
+  PrintTable("Volumes", fgVolumeTable, fgNofTopEntries, csvOutput);
+  PrintTable("Particles", fgParticleTable, fgNofTopEntries, csvOutput);
+  PrintTable("Processes", fgProcessTable, fgNofTopEntries, csvOutput);
+  G4cout << "======================================" << G4endl;
+
+  if (csvOutput) {
+    G4cout << "Profiler tables written in " << fgFileName << G4endl;
+  }
+
+  fgVolumeTable.clear();
+  fgParticleTable.clear();
+  fgProcessTable.clear();
+  fgComponentTable.clear();
+}
+
+//
+// private methods
+//
+
+//_____________________________________________________________________________
+void TG4StepProfiler::Clear()
+{
+  /// Clear the tables of this thread
+
+  fVolumeTable.clear();
+  fParticleTable.clear();
+  fProcessTable.clear();
+  for (G4int i = 0; i < kNofComponents; ++i) fComponents[i] = Entry();
+
+  fCurrentParticle = 0;
+  fCurrentParticleEntry = 0;
+  fCurrentProcess = 0;
+  fCurrentProcessEntry = 0;
+  fCurrentVolume = 0;
+  fCurrentVolumeEntry = 0;
+  fHasLastMark = false;
+}
+
+//
+// public methods
+//
+
+//_____________________________________________________________________________
+void TG4StepProfiler::StartStep(const G4Step* step)
+{
+  /// Accumulate the time since the last step mark and the step count
+  /// in the tables for the current volume, particle and creator process
+
+  Clock::time_point now = Clock::now();
+  G4double time = 0.;
+  if (fHasLastMark) {
+    std::chrono::duration<G4double> duration = now - fLastMark;
+    time = duration.count();
+  }
+
+  const G4Track* track = step->GetTrack();
+  const G4ParticleDefinition* particle = track->GetDefinition();
+  if (particle != fCurrentParticle || !fCurrentParticleEntry) {
+    fCurrentParticle = particle;
+    fCurrentParticleEntry = &fParticleTable[particle];
+  }
+
+  const G4VProcess* process = track->GetCreatorProcess();
+  if (process != fCurrentProcess || !fCurrentProcessEntry) {
+    fCurrentProcess = process;
+    fCurrentProcessEntry = &fProcessTable[process];
+  }
+
+  const G4VPhysicalVolume* pv = step->GetPreStepPoint()->GetPhysicalVolume();
+  const G4LogicalVolume* lv = pv ? pv->GetLogicalVolume() : 0;
+  if (lv != fCurrentVolume || !fCurrentVolumeEntry) {
+    fCurrentVolume = lv;
+    fCurrentVolumeEntry = &fVolumeTable[lv];
+  }
+
+  ++fCurrentParticleEntry->fNofSteps;
+  ++fCurrentProcessEntry->fNofSteps;
+  ++fCurrentVolumeEntry->fNofSteps;
+  fCurrentParticleEntry->fTime += time;
+  fCurrentProcessEntry->fTime += time;
+  fCurrentVolumeEntry->fTime += time;
+}
+
+//_____________________________________________________________________________
+void TG4StepProfiler::Merge()
+{
+  /// Add the tables of this thread to the merged tables (by names)
+  /// and clear them.
+  /// Called on each worker (or in sequential mode) at the end of run.
+
+#ifdef G4MULTITHREADED
+  G4AutoLock lm(&mergeProfilerMutex);
+#endif
+
+  for (const auto& entry : fVolumeTable) {
+    G4String name = entry.first ? entry.first->GetName() : G4String("none");
+    fgVolumeTable[name].fNofSteps += entry.second.fNofSteps;
+    fgVolumeTable[name].fTime += entry.second.fTime;
+  }
+
+  for (const auto& entry : fParticleTable) {
+    G4String name = entry.first->GetParticleName();
+    fgParticleTable[name].fNofSteps += entry.second.fNofSteps;
+    fgParticleTable[name].fTime += entry.second.fTime;
+  }
+
+  for (const auto& entry : fProcessTable) {
+    G4String name =
+      entry.first ? entry.first->GetProcessName() : G4String("primary");
+    fgProcessTable[name].fNofSteps += entry.second.fNofSteps;
+    fgProcessTable[name].fTime += entry.second.fTime;
+  }
+
+  for (G4int i = 0; i < kNofComponents; ++i) {
+    if (!fComponents[i].fNofSteps) continue;
+    G4String name = ComponentName(EComponent(i));
+    fgComponentTable[name].fNofSteps += fComponents[i].fNofSteps;
+    fgComponentTable[name].fTime += fComponents[i].fTime;
+  }
+
+  fgNofTopEntries = fNofTopEntries;
+  fgFileName = fFileName;
+
+  Clear();
+}
@@ -22,8 +22,13 @@
 #include <G4UserRunAction.hh>
 #include <globals.hh>
 
+#include <atomic>
+#include <vector>
+
 class G4ParticleDefinition;
 class G4Element;
+class G4Material;
+class G4HadronicProcessStore;
 
 class TObjArray;
 
@@ -59,6 +64,22 @@ class TObjArray;
 /// A selected cross section or all cross sections can be also printed via
 /// PrintCrossSection[s] methods.
 ///
+/// In the batch mode, activated by setting the batch file name, the
+/// histograms of the selected cross section types are made for all
+/// combinations of the batch particles with the batch elements (cross
+/// sections per atom in barn) and the batch materials (cross sections per
+/// volume in 1/cm) and they are written in one Root file.
+/// The batch jobs (one per particle and element or material) are prepared
+/// on master in PrepareBatch() and they are split in tasks, each covering
+/// a chunk of the energy and momentum bins, so that even a single job is
+/// distributed over threads. The tasks are processed in FillBatch() by all
+/// threads which call it at the end of run; each worker uses its own
+/// hadronic process store and takes the tasks not yet taken by other threads.
+/// The tasks left are processed on master, which then writes the histograms
+/// in WriteBatch(). As this is done in the run actions, the batch mode
+/// requires /run/beamOn N with N > 0. The batch file is recreated by
+/// default; it can be updated instead (see SetBatchFileMode()).
+///
 /// Implemented according to the Geant4 example: extended/hadronic/Hadr00.
 ///
 /// \author I. Hrivnacova; IPN, Orsay
@@ -96,12 +117,54 @@ class TG4CrossSectionManager : public TG4Verbose
   void SetMakeHistograms(G4bool makeHistograms);
   G4bool IsMakeHistograms() const;
 
+  // batch mode
+  static void FillBatch();
+  void PrepareBatch();
+  void WriteBatch();
+
+  void SetBatchParticleNames(const G4String& names);
+  void SetBatchElementNames(const G4String& names);
+  void SetBatchMaterialNames(const G4String& names);
+  void SetBatchTypes(const G4String& names);
+  void SetBatchFileName(const G4String& fileName);
+  void SetBatchFileMode(const G4String& fileMode);
+  G4bool IsBatchMode() const;
+
  private:
   /// Not implemented
   TG4CrossSectionManager(const TG4CrossSectionManager& right);
   /// Not implemented
   TG4CrossSectionManager& operator=(const TG4CrossSectionManager& right);
 
+  /// The batch job: the cross sections of one particle in one element
+  /// or material
+  struct TG4BatchJob
+  {
+    /// the particle
+    const G4ParticleDefinition* fParticle = nullptr;
+    /// the element (nullptr if material)
+    const G4Element* fElement = nullptr;
+    /// the material (nullptr if element)
+    const G4Material* fMaterial = nullptr;
+    /// the cross section values per type and kinetic energy bin
+    std::vector<G4double> fValuesE[kNoCrossSectionType];
+    /// the cross section values per type and momentum bin
+    std::vector<G4double> fValuesP[kNoCrossSectionType];
+  };
+
+  /// The batch task: a chunk of the energy and momentum bins of one job;
+  /// the momentum bins are counted after the energy bins
+  struct TG4BatchTask
+  {
+    G4int fJobIndex = 0; ///< the job index
+    G4int fFirstBin = 0; ///< the first bin
+    G4int fLastBin = 0;  ///< the last bin (not included)
+  };
+
+  // static methods
+  static G4double GetBatchCrossSection(G4HadronicProcessStore* store,
+    const TG4BatchJob& job, TG4CrossSectionType type, G4double kinEnergy);
+
   // methods
   const G4ParticleDefinition* GetParticle() const;
   const G4Element* GetElement() const;
@@ -109,6 +172,7 @@ class TG4CrossSectionManager : public TG4Verbose
 
   void CreateHistograms();
   void FillHistograms();
+  void FillBatchTask(const TG4BatchTask& task);
 
   // static data members
   static const G4String fgkDefaultParticleName; ///< default particle name
@@ -122,6 +186,10 @@ class TG4CrossSectionManager : public TG4Verbose
   static const G4int fgkDefaultNofBinsE; ///< defualt number of bins in energy
   static const G4int fgkDefaultNofBinsP; ///< defualt number of bins in momentum
   static const G4double fgkDefaultKinEnergy; ///< defualt kinetic energy
+  static const G4int fgkBatchChunkSize; ///< number of bins per batch task
+
+  /// The manager with the batch jobs of the current run (on master)
+  static TG4CrossSectionManager* fgBatchManager;
 
   // data members
   TG4CrossSectionMessenger fMessenger; ///< messenger
@@ -138,6 +206,17 @@ class TG4CrossSectionManager : public TG4Verbose
   G4double fKinEnergy;    ///< current kinetic energy
   G4bool fIsInitialised;  ///< info if histograms are created
   G4bool fMakeHistograms; ///< option to make histograms (for ecternal use)
+
+  // batch mode
+  std::vector<G4String> fBatchParticleNames; ///< batch particle names
+  std::vector<G4String> fBatchElementNames;  ///< batch element names
+  std::vector<G4String> fBatchMaterialNames; ///< batch material names
+  std::vector<TG4CrossSectionType> fBatchTypes; ///< batch cross section types
+  G4String fBatchFileName;                   ///< batch output file name
+  G4String fBatchFileMode;                   ///< batch output file mode
+  std::vector<TG4BatchJob> fBatchJobs;       ///< batch jobs
+  std::vector<TG4BatchTask> fBatchTasks;     ///< batch tasks
+  std::atomic<G4int> fNextBatchTask;         ///< the next batch task index
 };
 
 // inline functions
@@ -209,6 +288,24 @@ inline void TG4CrossSectionManager::SetMakeHistograms(G4bool makeHistograms)
   fMakeHistograms = makeHistograms;
 }
 
+inline void TG4CrossSectionManager::SetBatchFileName(const G4String& fileName)
+{
+  /// Set the batch output file name (the batch mode is inactive if empty)
+  fBatchFileName = fileName;
+}
+
+inline void TG4CrossSectionManager::SetBatchFileMode(const G4String& fileMode)
+{
+  /// Set the batch output file mode ("RECREATE" or "UPDATE")
+  fBatchFileMode = fileMode;
+}
+
+inline G4bool TG4CrossSectionManager::IsBatchMode() const
+{
+  /// Return true if the batch mode is active
+  return !fBatchFileName.empty();
+}
+
 inline G4bool TG4CrossSectionManager::IsMakeHistograms() const
 {
   /// Return the option to make histograms (for external use)
@@ -43,6 +43,12 @@ class G4UIcmdWithADoubleAndUnit;
 /// - /mcCrossSection/setMomentum     value unit
 /// - /mcCrossSection/setLabel     label
 /// - /mcCrossSection/printCrossSection crossSectionType
+/// - /mcCrossSection/setBatchParticles particleName1 [particleName2 ...]
+/// - /mcCrossSection/setBatchElements  elementName1 [elementName2 ...]
+/// - /mcCrossSection/setBatchMaterials materialName1 [materialName2 ...]
+/// - /mcCrossSection/setBatchTypes     crossSectionType1 [...] | All
+/// - /mcCrossSection/setBatchFileName  fileName
+/// - /mcCrossSection/setBatchFileMode  RECREATE | UPDATE
 ///
 /// \author I. Hrivnacova; IPN, Orsay
 
@@ -80,6 +86,12 @@ class TG4CrossSectionMessenger : public G4UImessenger
   G4UIcmdWithADoubleAndUnit* fMomentumCmd;    ///< command: setMomentum
   G4UIcmdWithAString* fLabelCmd;              ///< command: setLabel
   G4UIcmdWithAString* fPrintCmd;              ///< command: printCrossSection
+  G4UIcmdWithAString* fBatchParticlesCmd;     ///< command: setBatchParticles
+  G4UIcmdWithAString* fBatchElementsCmd;      ///< command: setBatchElements
+  G4UIcmdWithAString* fBatchMaterialsCmd;     ///< command: setBatchMaterials
+  G4UIcmdWithAString* fBatchTypesCmd;         ///< command: setBatchTypes
+  G4UIcmdWithAString* fBatchFileNameCmd;      ///< command: setBatchFileName
+  G4UIcmdWithAString* fBatchFileModeCmd;      ///< command: setBatchFileMode
 };
 
 #endif // TG4_CROSS_SECTION_MESSENGER_H
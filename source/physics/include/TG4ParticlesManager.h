@@ -28,6 +28,7 @@
 #include <TMCParticleType.h>
 
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 class G4DynamicParticle;
@@ -101,10 +102,16 @@ class TG4ParticlesManager : public TG4Verbose
   // G4int GetPDGIonEncoding(G4int Z, G4int A, G4int iso) const;
   void AddParticleToPdgDatabase(
     const G4String& name, G4ParticleDefinition* particleDefinition);
+  G4int FindPDGEncoding(G4ParticleDefinition* particle);
 
   // static data members
   static TG4ParticlesManager* fgInstance; ///< this instance
 
+  /// The thread-local cache of the resolved PDG encodings
+  /// (destroyed at the thread exit)
+  static G4ThreadLocal std::unordered_map<const G4ParticleDefinition*, G4int>
+    fgPDGEncodingCache;
+
   //
   // data members
 
@@ -25,8 +25,15 @@
 #include <globals.hh>
 // clang-format on
 
+#include <cstdint>
+#include <map>
+#include <utility>
 #include <vector>
 
+class TG4Limits;
+
+class G4ProcessManager;
+
 /// \ingroup physics
 /// \brief The manager class for G3 process controls
 ///
@@ -34,6 +41,17 @@
 /// of physics processes in current tracking medium according
 /// to user setting via TVirtualMC::Gstpar() method.
 ///
+/// The controls of each TG4Limits are compiled, at their first use
+/// with a particle process manager, in the bit masks of the process
+/// indices with a control set and of the controls values. When a track
+/// crosses a boundary, only the processes which bits differ in the
+/// masks of the exited and entered media are switched; the crossing
+/// between media with the same controls does not change anything.
+/// The process activation before the first switch is kept for each
+/// switched process, so that only these processes are restored at the
+/// track end. The compiled masks are not updated if the controls
+/// are changed after their first use.
+///
 /// Note that the global activation/inactivation of
 /// physics processes via  TVirtualMC::SetProcess() method
 /// is not managed by this class.
@@ -42,12 +60,14 @@
 
 class TG4SpecialControlsV2 : public TG4Verbose
 {
-  /// The action to be performed in the current step
-  enum Switch
+  /// The word of the bit masks
+  using MaskWord = std::uint64_t;
+
+  /// The process controls compiled for the given limits and process manager
+  struct ControlMask
   {
-    kSwitch,   ///< switch the process activation
-    kReswitch, ///< switch the process activation back
-    kUnswitch  ///< do not switch the process activation
+    std::vector<MaskWord> fIsSet;    ///< processes with a control set
+    std::vector<MaskWord> fIsActive; ///< processes activated by the control
   };
 
  public:
@@ -69,7 +89,8 @@ class TG4SpecialControlsV2 : public TG4Verbose
   TG4SpecialControlsV2& operator=(const TG4SpecialControlsV2& right);
 
   // methods
-  void SetSwitch();
+  const ControlMask* GetControlMask(TG4Limits* limits);
+  void SwitchControls(const ControlMask* newMask);
   void Reset();
 
   // data members
@@ -80,17 +101,22 @@ class TG4SpecialControlsV2 : public TG4Verbose
   /// The current track
   const G4Track* fkTrack;
 
-  /// The action to be performed in the current step
-  Switch fSwitch;
+  /// The process manager of the current track particle
+  G4ProcessManager* fProcessManager;
 
-  /// Vector of the processes the activation of which is changed by this process
-  G4ProcessVector fSwitchedProcesses;
+  /// The compiled masks per limits and process manager
+  /// (0 if the limits do not change any process activation)
+  std::map<std::pair<const TG4Limits*, const G4ProcessManager*>,
+    ControlMask*>
+    fControlMasks;
 
-  /// Vector for storing the current values of the processes activation
-  TG4boolVector fSwitchedControls;
+  /// The mask applied in the current volume (0 if none)
+  const ControlMask* fCurrentMask;
 
-  /// vector of the origin process activations
-  TG4boolVector fProcessActivations;
+  /// The process activations before their first switch in the current
+  /// track (valid only for the processes with a control set in the
+  /// current mask)
+  std::vector<MaskWord> fOriginActivations;
 };
 
 inline Bool_t TG4SpecialControlsV2::IsApplicable() const
@@ -15,14 +15,21 @@
 ///
 /// \author I. Hrivnacova; IPN Orsay
 
+#include "TG4Limits.h"
+
 #include <G4VProcess.hh>
 
+#include <map>
+#include <utility>
+#include <vector>
+
 class TG4G3CutVector;
-class TG4Limits;
 class TG4TrackManager;
 
 class G4Track;
 class G4LossTableManager;
+class G4MaterialCutsCouple;
+class G4ParticleDefinition;
 
 /// \ingroup physics
 /// \brief Abstract base class for a special process that activates
@@ -32,15 +39,26 @@ class G4LossTableManager;
 /// by derived classes specific for each particle type
 /// (see TG4G3ParticleWSP.h).
 ///
+/// The step limit is computed from the cuts compiled in TG4Limits
+/// for the particle class of the process; only the checks flagged
+/// in the compiled cuts are performed and GetMinEkine() is called only
+/// in the track first step when the cut depends on the creator process.
+/// The min remaining range is first checked against the equivalent
+/// kinetic energy threshold, which is computed once per particle,
+/// range and material-cuts couple.
+///
 /// \author I. Hrivnacova; IPN Orsay
 
 class TG4VSpecialCuts : public G4VProcess
 {
  public:
-  TG4VSpecialCuts(const G4String& processName);
+  TG4VSpecialCuts(
+    const G4String& processName, TG4Limits::EParticleClass particleClass);
   virtual ~TG4VSpecialCuts();
 
   // methods
+  virtual void BuildPhysicsTable(const G4ParticleDefinition& particle);
+
   /// Return the kinetic energy limit
   virtual G4double GetMinEkine(
     const TG4Limits& limits, const G4Track& track) const = 0;
@@ -85,6 +103,26 @@ class TG4VSpecialCuts : public G4VProcess
   /// Not implemented
   TG4VSpecialCuts& operator=(const TG4VSpecialCuts& right);
 
+  // methods
+  G4double GetMinRangeEkine(const G4ParticleDefinition* particle,
+    G4double minRange, const G4MaterialCutsCouple* couple);
+
+  /// The key of the min range energy thresholds (particle, min range)
+  using MinRangeKey = std::pair<const G4ParticleDefinition*, G4double>;
+
+  /// The particle class of this process
+  TG4Limits::EParticleClass fParticleClass;
+
+  /// The kinetic energy thresholds equivalent to the min range per
+  /// material-cuts couple index (< 0 if not yet computed)
+  std::map<MinRangeKey, std::vector<G4double>> fMinRangeEkines;
+
+  /// The cached key of the min range energy thresholds
+  MinRangeKey fCurrentMinRangeKey;
+
+  /// The cached min range energy thresholds
+  std::vector<G4double>* fCurrentMinRangeEkines;
+
   /// The G4LossTableManager instance
   G4LossTableManager* fLossTableManager;
 
@@ -16,11 +16,15 @@
 #include "TG4Globals.h"
 #include "TG4RegionsManager.h"
 
+#include <G4AnalysisUtilities.hh>
 #include <G4HadronicProcessStore.hh>
+#include <G4Material.hh>
 #include <G4NistManager.hh>
 #include <G4ParticleDefinition.hh>
 #include <G4ParticleTable.hh>
 
+#include <TDirectory.h>
+#include <TFile.h>
 #include <TH1.h>
 #include <TObjArray.h>
 
@@ -28,6 +32,7 @@
 // generated from short units names
 #include <G4SystemOfUnits.hh>
 
+#include <algorithm>
 #include <iomanip>
 
 const G4String TG4CrossSectionManager::fgkDefaultParticleName = "proton";
@@ -39,6 +44,8 @@ const G4double TG4CrossSectionManager::fgkDefaultMaxMomentum = 100 * TeV;
 const G4int TG4CrossSectionManager::fgkDefaultNofBinsE = 700;
 const G4int TG4CrossSectionManager::fgkDefaultNofBinsP = 800;
 const G4double TG4CrossSectionManager::fgkDefaultKinEnergy = 1 * MeV;
+const G4int TG4CrossSectionManager::fgkBatchChunkSize = 100;
+TG4CrossSectionManager* TG4CrossSectionManager::fgBatchManager = nullptr;
 
 //_____________________________________________________________________________
 TG4CrossSectionManager::TG4CrossSectionManager()
@@ -56,7 +63,16 @@ TG4CrossSectionManager::TG4CrossSectionManager()
     fLabel(),
     fKinEnergy(fgkDefaultKinEnergy),
     fIsInitialised(false),
-    fMakeHistograms(false)
+    fMakeHistograms(false),
+    fBatchParticleNames(),
+    fBatchElementNames(),
+    fBatchMaterialNames(),
+    fBatchTypes(),
+    fBatchFileName(),
+    fBatchFileMode("RECREATE"),
+    fBatchJobs(),
+    fBatchTasks(),
+    fNextBatchTask(0)
 {
   /// Default constructor
 }
@@ -68,6 +84,61 @@ TG4CrossSectionManager::~TG4CrossSectionManager()
 
   // fHistograms->Delete();
   delete fHistograms;
+
+  if (fgBatchManager == this) fgBatchManager = nullptr;
+}
+
+//
+// static private methods
+//
+
+//_____________________________________________________________________________
+G4double TG4CrossSectionManager::GetBatchCrossSection(
+  G4HadronicProcessStore* store, const TG4BatchJob& job,
+  TG4CrossSectionType type, G4double kinEnergy)
+{
+  /// Return the cross section per atom for the job element or
+  /// the cross section per volume for the job material
+
+  const G4ParticleDefinition* particle = job.fParticle;
+
+  if (job.fElement) {
+    const G4Element* elm = job.fElement;
+    switch (type) {
+      case kElastic:
+        return store->GetElasticCrossSectionPerAtom(particle, kinEnergy, elm);
+      case kInelastic:
+        return store->GetInelasticCrossSectionPerAtom(
+          particle, kinEnergy, elm);
+      case kCapture:
+        return store->GetCaptureCrossSectionPerAtom(particle, kinEnergy, elm);
+      case kFission:
+        return store->GetFissionCrossSectionPerAtom(particle, kinEnergy, elm);
+      case kChargeExchange:
+        return store->GetChargeExchangeCrossSectionPerAtom(
+          particle, kinEnergy, elm);
+      default:
+        return 0;
+    }
+  }
+
+  const G4Material* mat = job.fMaterial;
+  switch (type) {
+    case kElastic:
+      return store->GetElasticCrossSectionPerVolume(particle, kinEnergy, mat);
+    case kInelastic:
+      return store->GetInelasticCrossSectionPerVolume(
+        particle, kinEnergy, mat);
+    case kCapture:
+      return store->GetCaptureCrossSectionPerVolume(particle, kinEnergy, mat);
+    case kFission:
+      return store->GetFissionCrossSectionPerVolume(particle, kinEnergy, mat);
+    case kChargeExchange:
+      return store->GetChargeExchangeCrossSectionPerVolume(
+        particle, kinEnergy, mat);
+    default:
+      return 0;
+  }
 }
 
 //
@@ -296,6 +367,77 @@ void TG4CrossSectionManager::FillHistograms()
   // fHistograms->Write();
 }
 
+//_____________________________________________________________________________
+void TG4CrossSectionManager::FillBatchTask(const TG4BatchTask& task)
+{
+  /// Fill the cross section values in the bins of the given batch task.
+  /// The value vectors are allocated in PrepareBatch() for the job cross
+  /// section types, so the tasks of the same job write in distinct elements.
+  /// The hadronic process store of the calling thread is used.
+
+  G4HadronicProcessStore* store = G4HadronicProcessStore::Instance();
+  TG4BatchJob& job = fBatchJobs[task.fJobIndex];
+  G4double mass = job.fParticle->GetPDGMass();
+
+  G4double e1 = std::log10(fMinKinEnergy / MeV);
+  G4double e2 = std::log10(fMaxKinEnergy / MeV);
+  G4double de = (e2 - e1) / G4double(fNofBinsE);
+  G4double p1 = std::log10(fMinMomentum / GeV);
+  G4double p2 = std::log10(fMaxMomentum / GeV);
+  G4double dp = (p2 - p1) / G4double(fNofBinsP);
+
+  for (G4int bin = task.fFirstBin; bin < task.fLastBin; ++bin) {
+    if (bin < fNofBinsE) {
+      G4double e = std::pow(10., e1 + (bin + 0.5) * de) * MeV;
+      for (G4int type = 0; type < kNoCrossSectionType; ++type) {
+        if (job.fValuesE[type].empty()) continue;
+        job.fValuesE[type][bin] =
+          GetBatchCrossSection(store, job, GetCrossSectionType(type), e);
+      }
+    }
+    else {
+      G4int i = bin - fNofBinsE;
+      G4double p = std::pow(10., p1 + (i + 0.5) * dp) * GeV;
+      G4double e = std::sqrt(p * p + mass * mass) - mass;
+      for (G4int type = 0; type < kNoCrossSectionType; ++type) {
+        if (job.fValuesP[type].empty()) continue;
+        job.fValuesP[type][i] =
+          GetBatchCrossSection(store, job, GetCrossSectionType(type), e);
+      }
+    }
+  }
+}
+
+//
+// static public methods
+//
+
+//_____________________________________________________________________________
+void TG4CrossSectionManager::FillBatch()
+{
+  /// Fill the batch tasks of the current run which were not yet taken by
+  /// another thread. The tasks are taken one by one, so they are distributed
+  /// over all workers calling this function at the end of run, each
+  /// querying its own hadronic process store; the tasks left (all tasks in
+  /// sequential mode) are then processed on master.
+
+  TG4CrossSectionManager* manager = fgBatchManager;
+  if (!manager) return;
+
+  G4int nofTasks = manager->fBatchTasks.size();
+  G4int nofFilled = 0;
+  G4int i;
+  while ((i = manager->fNextBatchTask++) < nofTasks) {
+    manager->FillBatchTask(manager->fBatchTasks[i]);
+    ++nofFilled;
+  }
+
+  if (manager->VerboseLevel() > 1) {
+    G4cout << "TG4CrossSectionManager: " << nofFilled
+           << " batch tasks filled in this thread." << G4endl;
+  }
+}
+
 //
 // public methods
 //
@@ -390,3 +532,266 @@ void TG4CrossSectionManager::SetMomentum(G4double momentum)
   G4double mass = particle->GetPDGMass();
   fKinEnergy = std::sqrt(momentum * momentum + mass * mass) - mass;
 }
+
+//_____________________________________________________________________________
+void TG4CrossSectionManager::PrepareBatch()
+{
+  /// Create the batch jobs for all combinations of the batch particles with
+  /// the batch elements and materials and split them in tasks of
+  /// fgkBatchChunkSize bins. This method has to be called on master before
+  /// the workers start the run (in BeginOfRunAction).
+
+  fBatchJobs.clear();
+  fBatchTasks.clear();
+  fNextBatchTask = 0;
+  if (fgBatchManager == this) fgBatchManager = nullptr;
+
+  if (!IsBatchMode()) return;
+
+  // Use the default types if no types were selected
+  std::vector<TG4CrossSectionType> types = fBatchTypes;
+  if (types.empty()) {
+    for (G4int i = 0; i < kNoCrossSectionType; ++i) {
+      if (i == kChargeExchange) continue;
+      types.push_back(GetCrossSectionType(i));
+    }
+  }
+
+  std::vector<const G4Element*> elements;
+  for (const auto& name : fBatchElementNames) {
+    const G4Element* element =
+      G4NistManager::Instance()->FindOrBuildElement(name);
+    if (!element) {
+      TString text = "Element \"";
+      text += name.data();
+      text += "\" not found.";
+      TG4Globals::Warning("TG4CrossSectionManager", "PrepareBatch", text);
+      continue;
+    }
+    elements.push_back(element);
+  }
+
+  std::vector<const G4Material*> materials;
+  for (const auto& name : fBatchMaterialNames) {
+    const G4Material* material = G4Material::GetMaterial(name, false);
+    if (!material) {
+      material = G4NistManager::Instance()->FindOrBuildMaterial(name);
+    }
+    if (!material) {
+      TString text = "Material \"";
+      text += name.data();
+      text += "\" not found.";
+      TG4Globals::Warning("TG4CrossSectionManager", "PrepareBatch", text);
+      continue;
+    }
+    materials.push_back(material);
+  }
+
+  for (const auto& name : fBatchParticleNames) {
+    const G4ParticleDefinition* particle =
+      G4ParticleTable::GetParticleTable()->FindParticle(name);
+    if (!particle) {
+      TString text = "Particle \"";
+      text += name.data();
+      text += "\" not found.";
+      TG4Globals::Warning("TG4CrossSectionManager", "PrepareBatch", text);
+      continue;
+    }
+
+    TG4BatchJob job;
+    job.fParticle = particle;
+    G4bool isNeutron = (particle->GetParticleName() == "neutron");
+    for (auto type : types) {
+      if ((type == kCapture || type == kFission) && !isNeutron) continue;
+      job.fValuesE[type].resize(fNofBinsE);
+      if (type == kElastic || type == kInelastic) {
+        job.fValuesP[type].resize(fNofBinsP);
+      }
+    }
+    for (auto element : elements) {
+      job.fElement = element;
+      fBatchJobs.push_back(job);
+    }
+    job.fElement = nullptr;
+    for (auto material : materials) {
+      job.fMaterial = material;
+      fBatchJobs.push_back(job);
+    }
+  }
+
+  if (fBatchJobs.empty()) {
+    TG4Globals::Warning(
+      "TG4CrossSectionManager", "PrepareBatch", "No batch jobs defined.");
+    return;
+  }
+
+  G4int nofBins = fNofBinsE + fNofBinsP;
+  for (G4int i = 0; i < G4int(fBatchJobs.size()); ++i) {
+    for (G4int bin = 0; bin < nofBins; bin += fgkBatchChunkSize) {
+      TG4BatchTask task;
+      task.fJobIndex = i;
+      task.fFirstBin = bin;
+      task.fLastBin = std::min(bin + fgkBatchChunkSize, nofBins);
+      fBatchTasks.push_back(task);
+    }
+  }
+
+  if (VerboseLevel() > 0) {
+    G4cout << "TG4CrossSectionManager: " << fBatchJobs.size()
+           << " batch jobs prepared in " << fBatchTasks.size() << " tasks."
+           << G4endl;
+  }
+
+  fgBatchManager = this;
+}
+
+//_____________________________________________________________________________
+void TG4CrossSectionManager::WriteBatch()
+{
+  /// Create the histograms from the batch jobs and write them in the batch
+  /// file, which is opened in the batch file mode ("RECREATE" by default).
+  /// This method has to be called on master when all workers have
+  /// finished the run; the tasks not yet filled are filled first.
+
+  if (fgBatchManager != this) return;
+
+  // Fill the jobs which were not yet filled, if any
+  FillBatch();
+  fgBatchManager = nullptr;
+
+  TDirectory::TContext context;
+  TFile file(fBatchFileName.data(), fBatchFileMode.data());
+  if (file.IsZombie()) {
+    TString text = "Cannot open the batch file ";
+    text += fBatchFileName.data();
+    TG4Globals::Warning("TG4CrossSectionManager", "WriteBatch", text);
+    fBatchJobs.clear();
+    fBatchTasks.clear();
+    return;
+  }
+
+  G4double e1 = std::log10(fMinKinEnergy / MeV);
+  G4double e2 = std::log10(fMaxKinEnergy / MeV);
+  G4double p1 = std::log10(fMinMomentum / GeV);
+  G4double p2 = std::log10(fMaxMomentum / GeV);
+
+  G4int nofHistograms = 0;
+  for (const auto& job : fBatchJobs) {
+    G4String targetName =
+      job.fElement ? job.fElement->GetName() : job.fMaterial->GetName();
+    G4double unit = job.fElement ? barn : 1. / cm;
+    G4String unitName = job.fElement ? "(barn)" : "(1/cm)";
+
+    TString name0(job.fParticle->GetParticleName().data());
+    name0 += "_";
+    name0 += targetName.data();
+    name0 += "_";
+
+    TString title0(fLabel.data());
+    title0 += ": ";
+    title0 += job.fParticle->GetParticleName().data();
+    title0 += " - ";
+    title0 += targetName.data();
+    title0 += " : ";
+
+    for (G4int type = 0; type < kNoCrossSectionType; ++type) {
+      TString typeName = TG4CrossSectionTypeName(type).data();
+
+      const std::vector<G4double>& valuesE = job.fValuesE[type];
+      if (valuesE.size()) {
+        TString title = title0 + typeName + " cross section " +
+                        unitName.data() + " as a functions of log10(E/MeV)";
+        TH1D histogram(name0 + typeName + "_E", title, fNofBinsE, e1, e2);
+        for (G4int j = 0; j < fNofBinsE; ++j) {
+          histogram.SetBinContent(j + 1, valuesE[j] / unit);
+        }
+        histogram.Write();
+        ++nofHistograms;
+      }
+
+      const std::vector<G4double>& valuesP = job.fValuesP[type];
+      if (valuesP.size()) {
+        TString title = title0 + typeName + " cross section " +
+                        unitName.data() + " as a functions of log10(p/GeV)";
+        TH1D histogram(name0 + typeName + "_P", title, fNofBinsP, p1, p2);
+        for (G4int j = 0; j < fNofBinsP; ++j) {
+          histogram.SetBinContent(j + 1, valuesP[j] / unit);
+        }
+        histogram.Write();
+        ++nofHistograms;
+      }
+    }
+  }
+  file.Close();
+
+  if (VerboseLevel() > 0) {
+    G4cout << "TG4CrossSectionManager: " << nofHistograms
+           << " histograms written in " << fBatchFileName << G4endl;
+  }
+
+  fBatchJobs.clear();
+  fBatchTasks.clear();
+}
+
+//_____________________________________________________________________________
+void TG4CrossSectionManager::SetBatchParticleNames(const G4String& names)
+{
+  /// Set the list of the batch particle names (separated with spaces)
+
+  fBatchParticleNames.clear();
+  G4Analysis::Tokenize(names, fBatchParticleNames);
+}
+
+//_____________________________________________________________________________
+void TG4CrossSectionManager::SetBatchElementNames(const G4String& names)
+{
+  /// Set the list of the batch element names (separated with spaces)
+
+  fBatchElementNames.clear();
+  G4Analysis::Tokenize(names, fBatchElementNames);
+}
+
+//_____________________________________________________________________________
+void TG4CrossSectionManager::SetBatchMaterialNames(const G4String& names)
+{
+  /// Set the list of the batch material names (separated with spaces);
+  /// the material names with spaces are not supported.
+
+  fBatchMaterialNames.clear();
+  G4Analysis::Tokenize(names, fBatchMaterialNames);
+}
+
+//_____________________________________________________________________________
+void TG4CrossSectionManager::SetBatchTypes(const G4String& names)
+{
+  /// Set the list of the batch cross section types (separated with spaces);
+  /// "All" selects all types. If no type is set, all types except charge
+  /// exchange are used.
+
+  std::vector<G4String> typeNames;
+  G4Analysis::Tokenize(names, typeNames);
+
+  fBatchTypes.clear();
+  for (const auto& typeName : typeNames) {
+    if (typeName == "All") {
+      fBatchTypes.clear();
+      for (G4int i = 0; i < kNoCrossSectionType; ++i) {
+        fBatchTypes.push_back(GetCrossSectionType(i));
+      }
+      return;
+    }
+
+    TG4CrossSectionType type = GetCrossSectionType(typeName);
+    if (type == kNoCrossSectionType) {
+      TString text = "Cross section type \"";
+      text += typeName.data();
+      text += "\" not defined.";
+      TG4Globals::Warning("TG4CrossSectionManager", "SetBatchTypes", text);
+      continue;
+    }
+    if (std::find(fBatchTypes.begin(), fBatchTypes.end(), type) ==
+        fBatchTypes.end()) {
+      fBatchTypes.push_back(type);
+    }
+  }
+}
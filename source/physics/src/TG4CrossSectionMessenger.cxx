@@ -42,7 +42,13 @@ TG4CrossSectionMessenger::TG4CrossSectionMessenger(
     fMaxMomentumCmd(0),
     fMomentumCmd(0),
     fLabelCmd(0),
-    fPrintCmd(0)
+    fPrintCmd(0),
+    fBatchParticlesCmd(0),
+    fBatchElementsCmd(0),
+    fBatchMaterialsCmd(0),
+    fBatchTypesCmd(0),
+    fBatchFileNameCmd(0),
+    fBatchFileModeCmd(0)
 {
   /// Standard constructor
 
@@ -131,6 +137,66 @@ TG4CrossSectionMessenger::TG4CrossSectionMessenger(
   }
   fPrintCmd->SetCandidates(candidates);
   fPrintCmd->AvailableForStates(G4State_Idle);
+
+  fBatchParticlesCmd =
+    new G4UIcmdWithAString("/mcCrossSection/setBatchParticles", this);
+  fBatchParticlesCmd->SetGuidance(
+    "Set the list of particle names for the batch mode");
+  fBatchParticlesCmd->SetParameterName("particleNames", false);
+  fBatchParticlesCmd->AvailableForStates(
+    G4State_PreInit, G4State_Init, G4State_Idle);
+
+  fBatchElementsCmd =
+    new G4UIcmdWithAString("/mcCrossSection/setBatchElements", this);
+  fBatchElementsCmd->SetGuidance(
+    "Set the list of chemical element names for the batch mode");
+  fBatchElementsCmd->SetParameterName("elementNames", false);
+  fBatchElementsCmd->AvailableForStates(
+    G4State_PreInit, G4State_Init, G4State_Idle);
+
+  fBatchMaterialsCmd =
+    new G4UIcmdWithAString("/mcCrossSection/setBatchMaterials", this);
+  fBatchMaterialsCmd->SetGuidance(
+    "Set the list of material names for the batch mode");
+  fBatchMaterialsCmd->SetParameterName("materialNames", false);
+  fBatchMaterialsCmd->AvailableForStates(
+    G4State_PreInit, G4State_Init, G4State_Idle);
+
+  fBatchTypesCmd =
+    new G4UIcmdWithAString("/mcCrossSection/setBatchTypes", this);
+  fBatchTypesCmd->SetGuidance(
+    "Set the list of cross section types for the batch mode");
+  fBatchTypesCmd->SetGuidance(
+    "(All = all types; default: all types except ChargeExchange)");
+  fBatchTypesCmd->SetParameterName("crossSectionTypes", false);
+  fBatchTypesCmd->AvailableForStates(
+    G4State_PreInit, G4State_Init, G4State_Idle);
+
+  fBatchFileNameCmd =
+    new G4UIcmdWithAString("/mcCrossSection/setBatchFileName", this);
+  fBatchFileNameCmd->SetGuidance(
+    "Set the Root file name for the batch mode histograms;");
+  fBatchFileNameCmd->SetGuidance(
+    "the batch mode is activated when the file name is set.");
+  fBatchFileNameCmd->SetGuidance(
+    "The histograms are filled and written at the end of run, so the run");
+  fBatchFileNameCmd->SetGuidance(
+    "must be started with /run/beamOn N, N > 0 (beamOn 0 does not call");
+  fBatchFileNameCmd->SetGuidance("the user run actions).");
+  fBatchFileNameCmd->SetParameterName("fileName", false);
+  fBatchFileNameCmd->AvailableForStates(
+    G4State_PreInit, G4State_Init, G4State_Idle);
+
+  fBatchFileModeCmd =
+    new G4UIcmdWithAString("/mcCrossSection/setBatchFileMode", this);
+  fBatchFileModeCmd->SetGuidance(
+    "Set the Root file mode for the batch mode histograms:");
+  fBatchFileModeCmd->SetGuidance(
+    "RECREATE (default) or UPDATE (keep the histograms of previous runs)");
+  fBatchFileModeCmd->SetParameterName("fileMode", false);
+  fBatchFileModeCmd->SetCandidates("RECREATE UPDATE");
+  fBatchFileModeCmd->AvailableForStates(
+    G4State_PreInit, G4State_Init, G4State_Idle);
 }
 
 //_____________________________________________________________________________
@@ -152,6 +218,12 @@ TG4CrossSectionMessenger::~TG4CrossSectionMessenger()
   delete fLabelCmd;
   delete fMomentumCmd;
   delete fPrintCmd;
+  delete fBatchParticlesCmd;
+  delete fBatchElementsCmd;
+  delete fBatchMaterialsCmd;
+  delete fBatchTypesCmd;
+  delete fBatchFileNameCmd;
+  delete fBatchFileModeCmd;
 }
 
 //
@@ -214,4 +286,22 @@ void TG4CrossSectionMessenger::SetNewValue(
     else
       fCrossSectionManager->PrintCrossSection(GetCrossSectionType(newValue));
   }
+  else if (command == fBatchParticlesCmd) {
+    fCrossSectionManager->SetBatchParticleNames(newValue);
+  }
+  else if (command == fBatchElementsCmd) {
+    fCrossSectionManager->SetBatchElementNames(newValue);
+  }
+  else if (command == fBatchMaterialsCmd) {
+    fCrossSectionManager->SetBatchMaterialNames(newValue);
+  }
+  else if (command == fBatchTypesCmd) {
+    fCrossSectionManager->SetBatchTypes(newValue);
+  }
+  else if (command == fBatchFileNameCmd) {
+    fCrossSectionManager->SetBatchFileName(newValue);
+  }
+  else if (command == fBatchFileModeCmd) {
+    fCrossSectionManager->SetBatchFileMode(newValue);
+  }
 }
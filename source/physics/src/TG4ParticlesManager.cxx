@@ -51,6 +51,8 @@ G4Mutex addParticleMutex = G4MUTEX_INITIALIZER;
 #endif
 
 TG4ParticlesManager* TG4ParticlesManager::fgInstance = 0;
+G4ThreadLocal std::unordered_map<const G4ParticleDefinition*, G4int>
+  TG4ParticlesManager::fgPDGEncodingCache;
 
 //_____________________________________________________________________________
 TG4ParticlesManager::TG4ParticlesManager()
@@ -99,6 +101,12 @@ void TG4ParticlesManager::AddParticleToPdgDatabase(
 {
   /// Add the particle definition in TDatabasePDG
 
+  // The check and the addition are done in the same lock, so that
+  // the particle is added only once when called from more threads
+#ifdef G4MULTITHREADED
+  G4AutoLock lm(&addParticleMutex);
+#endif
+
   // Return if particle was already added
   G4int pdgEncoding = particleDefinition->GetPDGEncoding();
   TParticlePDG* particlePDG =
@@ -123,9 +131,6 @@ void TG4ParticlesManager::AddParticleToPdgDatabase(
   }
 
   // Add particle to TDatabasePDG
-#ifdef G4MULTITHREADED
-  G4AutoLock lm(&addParticleMutex);
-#endif
   TDatabasePDG::Instance()->AddParticle(name, g4Name,
     particleDefinition->GetPDGMass() * TG4G3Units::InverseEnergy(),
     particleDefinition->GetPDGStable(),
@@ -136,6 +141,50 @@ void TG4ParticlesManager::AddParticleToPdgDatabase(
 #endif
 }
 
+//_____________________________________________________________________________
+G4int TG4ParticlesManager::FindPDGEncoding(G4ParticleDefinition* particle)
+{
+  /// Return the PDG code of particle;
+  /// if standard PDG code is not defined the TDatabasePDG
+  /// is used.
+
+  // Get PDG encoding from G4 particle definition
+  G4int pdgEncoding = particle->GetPDGEncoding();
+  if (pdgEncoding && (pdgEncoding != -22)) {
+    // Add particle to TDatabasePDG
+    if (!TDatabasePDG::Instance()->GetParticle(pdgEncoding))
+      AddParticleToPdgDatabase(particle->GetParticleName(), particle);
+    return pdgEncoding;
+  }
+
+  // Get PDG encoding from TDatabasePDG if not defined in Geant4
+
+  // get particle name from the name map
+  G4String g4name = particle->GetParticleName();
+  G4String tname = fParticleNameMap.GetSecond(g4name);
+  if (tname == "ChargedRootino") tname = "Rootino";
+  // special treatment for Rootino
+  // user can reset the particle title to ChargedRootino to interpret
+  // Rootino as chargedgeantino
+
+  if (tname == "Undefined") {
+    particle->DumpTable();
+    TG4Globals::Exception("TG4ParticlesManager", "GetPDGEncoding",
+      "Particle " + TString(g4name) + " was not found in the name map.");
+  }
+
+  // get particle from TDatabasePDG
+  TDatabasePDG* pdgDB = TDatabasePDG::Instance();
+  TParticlePDG* tparticle = pdgDB->GetParticle(tname);
+  if (!tparticle) {
+    TG4Globals::Exception("TG4ParticlesManager", "GetPDGEncoding",
+      "Particle " + TString(tname) + " was not found in TDatabasePDG.");
+  }
+
+  // get PDG encoding
+  return tparticle->PdgCode();
+}
+
 //
 // public methods
 //
@@ -465,42 +514,17 @@ G4int TG4ParticlesManager::GetPDGEncoding(G4ParticleDefinition* particle)
   /// Return the PDG code of particle;
   /// if standard PDG code is not defined the TDatabasePDG
   /// is used.
+  /// The resolved codes are cached per particle definition (per thread),
+  /// so that TDatabasePDG is queried only at the first call for each
+  /// particle type.
 
-  // Get PDG encoding from G4 particle definition
-  G4int pdgEncoding = particle->GetPDGEncoding();
-  if (pdgEncoding && (pdgEncoding != -22)) {
-    // Add particle to TDatabasePDG
-    if (!TDatabasePDG::Instance()->GetParticle(pdgEncoding))
-      AddParticleToPdgDatabase(particle->GetParticleName(), particle);
-    return pdgEncoding;
-  }
+  auto it = fgPDGEncodingCache.find(particle);
+  if (it != fgPDGEncodingCache.end()) return it->second;
 
-  // Get PDG encoding from TDatabasePDG if not defined in Geant4
+  G4int pdgEncoding = FindPDGEncoding(particle);
+  fgPDGEncodingCache[particle] = pdgEncoding;
 
-  // get particle name from the name map
-  G4String g4name = particle->GetParticleName();
-  G4String tname = fParticleNameMap.GetSecond(g4name);
-  if (tname == "ChargedRootino") tname = "Rootino";
-  // special treatment for Rootino
-  // user can reset the particle title to ChargedRootino to interpret
-  // Rootino as chargedgeantino
-
-  if (tname == "Undefined") {
-    particle->DumpTable();
-    TG4Globals::Exception("TG4ParticlesManager", "GetPDGEncoding",
-      "Particle " + TString(g4name) + " was not found in the name map.");
-  }
-
-  // get particle from TDatabasePDG
-  TDatabasePDG* pdgDB = TDatabasePDG::Instance();
-  TParticlePDG* tparticle = pdgDB->GetParticle(tname);
-  if (!tparticle) {
-    TG4Globals::Exception("TG4ParticlesManager", "GetPDGEncoding",
-      "Particle " + TString(tname) + " was not found in TDatabasePDG.");
-  }
-
-  // get PDG encoding
-  return tparticle->PdgCode();
+  return pdgEncoding;
 }
 
 //_____________________________________________________________________________
@@ -22,15 +22,27 @@
 #include <G4ProcessVector.hh>
 #include <G4StepStatus.hh>
 
+namespace
+{
+/// The number of bits in the mask word
+const G4int kNofWordBits = 64;
+
+/// Return the number of mask words needed for the given number of processes
+inline std::size_t GetNofWords(std::size_t nofProcesses)
+{
+  return nofProcesses / kNofWordBits + 1;
+}
+} // namespace
+
 //_____________________________________________________________________________
 TG4SpecialControlsV2::TG4SpecialControlsV2()
   : TG4Verbose("specialControlsV2"),
     fIsApplicable(false),
     fkTrack(0),
-    fSwitch(kUnswitch),
-    fSwitchedProcesses(),
-    fSwitchedControls(),
-    fProcessActivations()
+    fProcessManager(0),
+    fControlMasks(),
+    fCurrentMask(0),
+    fOriginActivations()
 {
   /// Standard constructor
 }
@@ -39,6 +51,8 @@ TG4SpecialControlsV2::TG4SpecialControlsV2()
 TG4SpecialControlsV2::~TG4SpecialControlsV2()
 {
   /// Destructor
+
+  for (auto& entry : fControlMasks) delete entry.second;
 }
 
 //
@@ -46,59 +60,111 @@ TG4SpecialControlsV2::~TG4SpecialControlsV2()
 //
 
 //_____________________________________________________________________________
-void TG4SpecialControlsV2::SetSwitch()
+const TG4SpecialControlsV2::ControlMask* TG4SpecialControlsV2::GetControlMask(
+  TG4Limits* limits)
 {
-  /// Define the action which should be performed at this step
+  /// Return the control mask for the given limits and the current
+  /// process manager; compile it at the first call.
+  /// Return 0 if the limits do not change any process activation.
 
-  // get limits
-#ifdef MCDEBUG
-  TG4Limits* limits = TG4GeometryServices::Instance()->GetLimits(
-    fkTrack->GetNextVolume()->GetLogicalVolume()->GetUserLimits());
-#else
-  TG4Limits* limits =
-    (TG4Limits*)fkTrack->GetNextVolume()->GetLogicalVolume()->GetUserLimits();
-#endif
+  if (!limits->IsControl()) return 0;
 
-  if (!limits) {
-    TG4Globals::Warning("TG4SpecialControlsV2", "SetSwitch",
-      "No limits defined in " +
-        TString(fkTrack->GetNextVolume()->GetLogicalVolume()->GetName()));
-    return;
+  auto key = std::make_pair(limits, fProcessManager);
+  auto it = fControlMasks.find(key);
+  if (it != fControlMasks.end()) return it->second;
+
+  G4ProcessVector* processVector = fProcessManager->GetProcessList();
+  std::size_t nofWords = GetNofWords(processVector->length());
+
+  ControlMask* mask = new ControlMask();
+  mask->fIsSet.resize(nofWords, 0);
+  mask->fIsActive.resize(nofWords, 0);
+
+  G4bool isEmpty = true;
+  for (std::size_t i = 0; i < processVector->length(); i++) {
+    TG4G3ControlValue control = limits->GetControl((*processVector)[i]);
+    if (control == kUnsetControlValue) continue;
+
+    MaskWord bit = MaskWord(1) << (i % kNofWordBits);
+    mask->fIsSet[i / kNofWordBits] |= bit;
+    if (control != kInActivate) mask->fIsActive[i / kNofWordBits] |= bit;
+    isEmpty = false;
   }
 
-  if (fSwitch != kUnswitch) {
-    if (limits->IsControl()) {
-      // particle is exiting a logical volume with special controls
-      // and entering another logical volume with special controls
-      fSwitch = kReswitch;
-      if (VerboseLevel() > 1) G4cout << "kReswitch" << G4endl;
-    }
-    else {
-      // particle is exiting a logical volume with special controls
-      // and entering a logical volume without special controls
-      fSwitch = kUnswitch;
-      if (VerboseLevel() > 1) G4cout << "kUnswitch" << G4endl;
-    }
+  if (isEmpty) {
+    delete mask;
+    mask = 0;
   }
-  else if (limits->IsControl()) {
-    // particle is entering a logical volume with special controls
-    // that have not yet been set
-    fSwitch = kSwitch;
-    if (VerboseLevel() > 1) G4cout << "kSwitch" << G4endl;
+
+  if (VerboseLevel() > 1) {
+    G4cout << "Compiled controls mask for " << limits->GetName() << " and "
+           << fkTrack->GetDefinition()->GetParticleName() << G4endl;
   }
+
+  fControlMasks[key] = mask;
+  return mask;
 }
 
 //_____________________________________________________________________________
-void TG4SpecialControlsV2::Reset()
+void TG4SpecialControlsV2::SwitchControls(const ControlMask* newMask)
 {
-  /// Reset the buffers to the initial state.
+  /// Switch the activation of the processes which differ in the current
+  /// and the new mask: a process with a control set in the new mask gets
+  /// the control value, a process with a control set only in the current
+  /// mask gets back its origin activation.
+
+  if (newMask == fCurrentMask) return;
+
+  for (std::size_t word = 0; word < fOriginActivations.size(); ++word) {
+    MaskWord oldSet = fCurrentMask ? fCurrentMask->fIsSet[word] : 0;
+    MaskWord oldActive = fCurrentMask ? fCurrentMask->fIsActive[word] : 0;
+    MaskWord newSet = newMask ? newMask->fIsSet[word] : 0;
+    MaskWord newActive = newMask ? newMask->fIsActive[word] : 0;
+
+    MaskWord diff =
+      (oldSet ^ newSet) | (oldSet & newSet & (oldActive ^ newActive));
+
+    for (G4int bit = 0; diff; ++bit, diff >>= 1) {
+      if (!(diff & 1)) continue;
+
+      G4int index = word * kNofWordBits + bit;
+      MaskWord bitMask = MaskWord(1) << bit;
+      G4bool activation = fProcessManager->GetProcessActivation(index);
+
+      if (!(oldSet & bitMask)) {
+        // save the process activation before its first switch
+        if (activation)
+          fOriginActivations[word] |= bitMask;
+        else
+          fOriginActivations[word] &= ~bitMask;
+      }
+
+      G4bool newActivation = (newSet & bitMask)
+                               ? (newActive & bitMask) != 0
+                               : (fOriginActivations[word] & bitMask) != 0;
+
+      if (newActivation != activation) {
+        if (VerboseLevel() > 1) {
+          G4VProcess* process = (*fProcessManager->GetProcessList())[index];
+          G4cout << "Set process " << (newActivation ? "" : "in")
+                 << "activation for " << process->GetProcessName() << G4endl;
+        }
+        fProcessManager->SetProcessActivation(index, newActivation);
+      }
+    }
+  }
+
+  fCurrentMask = newMask;
+}
 
-  fSwitch = kUnswitch;
+//_____________________________________________________________________________
+void TG4SpecialControlsV2::Reset()
+{
+  /// Reset the track data to the initial state.
 
-  // clear buffers
-  fSwitchedProcesses.clear();
-  fSwitchedControls.clear();
-  fProcessActivations.clear();
+  fkTrack = 0;
+  fProcessManager = 0;
+  fCurrentMask = 0;
 }
 
 //
@@ -108,7 +174,8 @@ void TG4SpecialControlsV2::Reset()
 //_____________________________________________________________________________
 void TG4SpecialControlsV2::StartTrack(const G4Track* track)
 {
-  /// Store the processes activations in fProcessActivations vector
+  /// Check the applicability for the track particle and apply the controls
+  /// in the track start volume
 
   // check applicability
   G4ParticleDefinition* particle = track->GetDefinition();
@@ -124,15 +191,10 @@ void TG4SpecialControlsV2::StartTrack(const G4Track* track)
   // set applicability, current track
   fIsApplicable = true;
   fkTrack = track;
-
-  // save origin process activation
-  G4ProcessManager* processManager =
-    track->GetDefinition()->GetProcessManager();
-  G4ProcessVector* processVector = processManager->GetProcessList();
-
-  for (size_t i = 0; i < processVector->length(); i++) {
-    fProcessActivations.push_back(processManager->GetProcessActivation(i));
-  }
+  fProcessManager = particle->GetProcessManager();
+  fCurrentMask = 0;
+  fOriginActivations.assign(
+    GetNofWords(fProcessManager->GetProcessList()->length()), 0);
 
   // apply controls
   ApplyControls();
@@ -151,86 +213,32 @@ void TG4SpecialControlsV2::ApplyControls()
   }
 #endif
 
-  SetSwitch();
-
-  G4ProcessManager* processManager =
-    fkTrack->GetDefinition()->GetProcessManager();
-  G4ProcessVector* processVector = processManager->GetProcessList();
-
-  if (fSwitch == kUnswitch || fSwitch == kReswitch) {
+  // get limits
+#ifdef MCDEBUG
+  TG4Limits* limits = TG4GeometryServices::Instance()->GetLimits(
+    fkTrack->GetNextVolume()->GetLogicalVolume()->GetUserLimits());
+#else
+  TG4Limits* limits =
+    (TG4Limits*)fkTrack->GetNextVolume()->GetLogicalVolume()->GetUserLimits();
+#endif
 
-    // set processes activation back
-    for (size_t i = 0; i < fSwitchedProcesses.length(); i++) {
-      if (VerboseLevel() > 1) {
-        G4cout << "Reset process activation back in "
-               << fkTrack->GetNextVolume()->GetName() << G4endl;
-      }
-      processManager->SetProcessActivation(
-        fSwitchedProcesses[i], fSwitchedControls[i]);
-    }
-    fSwitchedProcesses.clear();
-    fSwitchedControls.clear();
+  if (!limits) {
+    TG4Globals::Warning("TG4SpecialControlsV2", "ApplyControls",
+      "No limits defined in " +
+        TString(fkTrack->GetNextVolume()->GetLogicalVolume()->GetName()));
+    return;
   }
 
-  if (fSwitch == kSwitch || fSwitch == kReswitch) {
-
-    // set TG4Limits processes controls
-    TG4Limits* limits =
-      (TG4Limits*)fkTrack->GetNextVolume()->GetLogicalVolume()->GetUserLimits();
-
-    for (size_t i = 0; i < processVector->length(); i++) {
-
-      TG4G3ControlValue control = limits->GetControl((*processVector)[i]);
-      G4bool activation = processManager->GetProcessActivation(i);
-
-      if (control != kUnsetControlValue &&
-          !TG4Globals::Compare(activation, control)) {
-
-        // store the current processes controls
-        if (VerboseLevel() > 1) {
-          G4cout << "Something goes to fSwitchedProcesses" << G4endl;
-        }
-        fSwitchedProcesses.insert((*processVector)[i]);
-        fSwitchedControls.push_back(activation);
-
-        // set new process activation
-        if (control == kInActivate) {
-          if (VerboseLevel() > 1) {
-            G4cout << "Set process inactivation for "
-                   << (*processVector)[i]->GetProcessName() << " in "
-                   << fkTrack->GetNextVolume()->GetName() << G4endl;
-          }
-          processManager->SetProcessActivation(i, false);
-        }
-        else {
-          // ((control == kActivate) || (control == kActivate2))
-          if (VerboseLevel() > 1) {
-            G4cout << "Set process activation for "
-                   << (*processVector)[i]->GetProcessName() << " in "
-                   << fkTrack->GetNextVolume()->GetName() << G4endl;
-          }
-          processManager->SetProcessActivation(i, true);
-        }
-      }
-    }
-  }
+  SwitchControls(GetControlMask(limits));
 }
 
 //_____________________________________________________________________________
 void TG4SpecialControlsV2::RestoreProcessActivations()
 {
-  /// Restore the processes activations from fProcessActivations vector
-  /// and reset values
-
-  G4ProcessManager* processManager =
-    fkTrack->GetDefinition()->GetProcessManager();
-  G4ProcessVector* processVector = processManager->GetProcessList();
+  /// Restore the origin activations of the processes switched
+  /// in the current volume and reset values
 
-  for (size_t i = 0; i < processVector->length(); i++) {
-    if (processManager->GetProcessActivation(i) != fProcessActivations[i]) {
-      processManager->SetProcessActivation(i, fProcessActivations[i]);
-    }
-  }
+  SwitchControls(0);
 
   Reset();
 }
@@ -22,7 +22,7 @@
 //_____________________________________________________________________________
 TG4SpecialCutsForChargedHadron::TG4SpecialCutsForChargedHadron(
   const G4String& processName)
-  : TG4VSpecialCuts(processName)
+  : TG4VSpecialCuts(processName, TG4Limits::kChargedHadronCuts)
 {
   /// Standard constructor
 }
@@ -50,7 +50,7 @@ G4double TG4SpecialCutsForChargedHadron::GetMinEkine(
 //_____________________________________________________________________________
 TG4SpecialCutsForElectron::TG4SpecialCutsForElectron(
   const G4String& processName)
-  : TG4VSpecialCuts(processName)
+  : TG4VSpecialCuts(processName, TG4Limits::kElectronCuts)
 {
   /// Standard and default constructor
 }
@@ -76,7 +76,7 @@ G4double TG4SpecialCutsForElectron::GetMinEkine(
 
 //_____________________________________________________________________________
 TG4SpecialCutsForGamma::TG4SpecialCutsForGamma(const G4String& processName)
-  : TG4VSpecialCuts(processName)
+  : TG4VSpecialCuts(processName, TG4Limits::kGammaCuts)
 {
   /// Standard and default constructor
 }
@@ -102,7 +102,7 @@ G4double TG4SpecialCutsForGamma::GetMinEkine(
 
 //_____________________________________________________________________________
 TG4SpecialCutsForMuon::TG4SpecialCutsForMuon(const G4String& processName)
-  : TG4VSpecialCuts(processName)
+  : TG4VSpecialCuts(processName, TG4Limits::kMuonCuts)
 {
   /// Standard and default constructor
 }
@@ -129,7 +129,7 @@ G4double TG4SpecialCutsForMuon::GetMinEkine(
 //_____________________________________________________________________________
 TG4SpecialCutsForNeutralHadron::TG4SpecialCutsForNeutralHadron(
   const G4String& processName)
-  : TG4VSpecialCuts(processName)
+  : TG4VSpecialCuts(processName, TG4Limits::kNeutralHadronCuts)
 {
   /// Standard and default constructor
 }
@@ -155,7 +155,7 @@ G4double TG4SpecialCutsForNeutralHadron::GetMinEkine(
 
 //_____________________________________________________________________________
 TG4SpecialCutsForNeutron::TG4SpecialCutsForNeutron(const G4String& processName)
-  : TG4VSpecialCuts(processName)
+  : TG4VSpecialCuts(processName, TG4Limits::kNeutralHadronCuts)
 {
   /// Standard and default constructor
 }
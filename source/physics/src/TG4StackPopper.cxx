@@ -15,6 +15,7 @@
 #include "TG4StackPopper.h"
 #include "TG4G3Units.h"
 #include "TG4ParticlesManager.h"
+#include "TG4StepProfiler.h"
 #include "TG4TrackInformation.h"
 
 #include <G4IonTable.hh>
@@ -87,6 +88,8 @@ G4VParticleChange* TG4StackPopper::PostStepDoIt(
 {
   /// Add particles from the stack as secondaries to the current particle
 
+  TG4ProfilerTimer timer(TG4StepProfiler::kStackPopper);
+
   aParticleChange.Initialize(track);
 
   if (fMCStack->GetNtrack() == fNofDoneTracks) return &aParticleChange;
@@ -21,13 +21,19 @@
 
 #include <G4EnergyLossTables.hh>
 #include <G4LossTableManager.hh>
+#include <G4MaterialCutsCouple.hh>
 #include <G4PhysicalConstants.hh>
 #include <G4TransportationProcessType.hh>
 #include <G4UserLimits.hh>
 
 //_____________________________________________________________________________
-TG4VSpecialCuts::TG4VSpecialCuts(const G4String& processName)
+TG4VSpecialCuts::TG4VSpecialCuts(
+  const G4String& processName, TG4Limits::EParticleClass particleClass)
   : G4VProcess(processName, fUserDefined),
+    fParticleClass(particleClass),
+    fMinRangeEkines(),
+    fCurrentMinRangeKey(0, 0.),
+    fCurrentMinRangeEkines(0),
     fLossTableManager(G4LossTableManager::Instance()),
     fTrackManager(TG4TrackManager::Instance())
 {
@@ -42,10 +48,52 @@ TG4VSpecialCuts::~TG4VSpecialCuts()
   /// Destructor
 }
 
+//
+// private methods
+//
+
+//_____________________________________________________________________________
+G4double TG4VSpecialCuts::GetMinRangeEkine(const G4ParticleDefinition* particle,
+  G4double minRange, const G4MaterialCutsCouple* couple)
+{
+  /// Return the kinetic energy corresponding to the given min range
+  /// for the given particle in the given material-cuts couple.
+  /// The value is computed from the loss tables at the first call
+  /// and then cached.
+
+  MinRangeKey key(particle, minRange);
+  if (!fCurrentMinRangeEkines || key != fCurrentMinRangeKey) {
+    fCurrentMinRangeKey = key;
+    fCurrentMinRangeEkines = &fMinRangeEkines[key];
+  }
+
+  std::size_t index = couple->GetIndex();
+  if (index >= fCurrentMinRangeEkines->size()) {
+    fCurrentMinRangeEkines->resize(index + 1, -1.);
+  }
+
+  G4double& ekine = (*fCurrentMinRangeEkines)[index];
+  if (ekine < 0.) {
+    ekine = fLossTableManager->GetEnergy(particle, minRange, couple);
+  }
+  return ekine;
+}
+
 //
 // public methods
 //
 
+//_____________________________________________________________________________
+void TG4VSpecialCuts::BuildPhysicsTable(
+  const G4ParticleDefinition& /*particle*/)
+{
+  /// Reset the cached min range energy thresholds, as the loss tables
+  /// or the material-cuts couples may have changed
+
+  fMinRangeEkines.clear();
+  fCurrentMinRangeEkines = 0;
+}
+
 //_____________________________________________________________________________
 G4double TG4VSpecialCuts::PostStepGetPhysicalInteractionLength(
   const G4Track& track, G4double /*previousStepSize*/,
@@ -76,21 +124,30 @@ G4double TG4VSpecialCuts::PostStepGetPhysicalInteractionLength(
     return 0.;
   }
 
+  // the cuts compiled for this particle class
+  const TG4Limits::ParticleCuts& cuts = limits->GetParticleCuts(fParticleClass);
+
   // min kinetic energy (from limits)
-  G4double minEkine = GetMinEkine(*limits, track);
-  if (track.GetKineticEnergy() <= minEkine) return 0.;
+  // the creator dependent cuts are evaluated only in the first step
+  G4double ekin = track.GetKineticEnergy();
+  G4double minEkine = cuts.fMinEkine;
+  if ((cuts.fChecks & TG4Limits::kFirstStepCheck) &&
+      track.GetCurrentStepNumber() == 1) {
+    minEkine = GetMinEkine(*limits, track);
+  }
+  if (ekin <= minEkine) return 0.;
 
   // max track length
-  proposedStep =
-    (limits->GetUserMaxTrackLength(track) - track.GetTrackLength());
-  if (proposedStep < 0.) return 0.;
+  if (cuts.fChecks & TG4Limits::kMaxTrackLengthCheck) {
+    proposedStep = cuts.fMaxTrackLength - track.GetTrackLength();
+    if (proposedStep < 0.) return 0.;
+  }
 
   // max time limit
-  G4double tlimit = limits->GetUserMaxTime(track);
-  if (tlimit < DBL_MAX) {
+  if (cuts.fChecks & TG4Limits::kMaxTimeCheck) {
     G4double beta = (track.GetDynamicParticle()->GetTotalMomentum()) /
                     (track.GetTotalEnergy());
-    G4double dTime = (tlimit - track.GetGlobalTime());
+    G4double dTime = (cuts.fMaxTime - track.GetGlobalTime());
     G4double temp = beta * c_light * dTime;
     if (temp < 0.) {
       return 0.;
@@ -102,14 +159,16 @@ G4double TG4VSpecialCuts::PostStepGetPhysicalInteractionLength(
 
   // min remaining range
   // (only for charged particle except for chargedGeantino)
-  G4double rmin = limits->GetUserMinRange(track);
-  if (rmin > DBL_MIN) {
-    G4ParticleDefinition* particle = track.GetDefinition();
+  if (cuts.fChecks & TG4Limits::kMinRangeCheck) {
+    const G4ParticleDefinition* particle = track.GetDefinition();
     if ((particle->GetPDGCharge() != 0.) && (particle->GetPDGMass() > 0.0)) {
-      G4double ekin = track.GetKineticEnergy();
       const G4MaterialCutsCouple* couple = track.GetMaterialCutsCouple();
+      // the remaining range is below the min range
+      if (ekin < GetMinRangeEkine(particle, cuts.fMinRange, couple)) {
+        return 0.;
+      }
       G4double rangeNow = fLossTableManager->GetRange(particle, ekin, couple);
-      G4double temp = rangeNow - rmin;
+      G4double temp = rangeNow - cuts.fMinRange;
       if (temp < 0.) {
         return 0.;
       }
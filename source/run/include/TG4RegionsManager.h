@@ -20,9 +20,12 @@
 #include <globals.hh>
 
 #include <map>
+#include <tuple>
+#include <vector>
 
 class TG4Limits;
 
+class G4ParticleDefinition;
 class G4Region;
 class G4Material;
 class G4VRangeToEnergyConverter;
@@ -44,12 +47,25 @@ class G4MaterialCutsCouple;
 ///   physics list, the VMC cut is ignored and the default range cut
 ///   is used
 /// - The range cut is first evaluated within the range 1e-03mm to 1m;
-///   when the range cut order is found, it is refined up to given
-///   precision (2 orders of magnitude by default) within 10 values
-///   of each order and the range value with the closest energy still
-///   smaller than VMC cut is chosen. \n
-///   It may happen that value cannot be refined up to given precision,
-///   then the best found value is returned.
+///   the table of energies for the range orders is inverted with a binary
+///   search and, when the range cut order is found, it is refined by
+///   bisection up to given precision (the number of decimal digits within
+///   the order) and the range value with the closest energy still
+///   smaller than VMC cut is chosen.
+/// - The energy cuts of all materials are converted before the regions
+///   are defined, in parallel in the number of threads set via
+///   /mcRegions/setNofThreads (the number of hardware threads by default).
+/// - When the regions are loaded from a file (/mcRegions/load), the loaded
+///   ranges are used for the materials which VMC cuts are unchanged with
+///   respect to the saved ones, the conversion is then performed only for
+///   the other materials. The loaded ranges are used only if the default
+///   range cuts and the range precision saved in the file are equal
+///   to the current ones.
+/// - Optionally (/mcRegions/mergeRegions tolerance), the regions which
+///   range cuts are equal within the given relative tolerance are merged
+///   in one region with shared production cuts; this reduces the number
+///   of material-cuts couples, for which the physics tables are built,
+///   when the materials are present in several regions.
 /// - The regions are defined only in case when the VMC cuts
 ///   result in range cuts different from the range cuts in default
 ///   region; then the region includes all logical volumes
@@ -94,6 +110,8 @@ class TG4RegionsManager : public TG4VRegionsManager
   void SetEnergyTolerance(G4double tolerance);
   void SetLoad(G4bool isLoad);
   void SetFromG4Table(G4bool isG4Table);
+  void SetNofThreads(G4int nofThreads);
+  void SetMergeTolerance(G4double tolerance);
 
   // get methods
   G4int GetRangePrecision() const;
@@ -101,28 +119,40 @@ class TG4RegionsManager : public TG4VRegionsManager
   G4String GetFileName() const;
   G4bool IsG4Table() const;
   G4bool IsLoad() const;
+  G4int GetNofThreads() const;
+  G4double GetMergeTolerance() const;
 
  private:
   using TG4RegionData = std::array<G4double, fgkValuesSize>;
+  /// The key of the converted cuts: particle, material, energy cut
+  using TG4CutKey =
+    std::tuple<const G4ParticleDefinition*, const G4Material*, G4double>;
 
   TG4RegionsManager(const TG4RegionsManager& right) = delete;
   TG4RegionsManager& operator=(const TG4RegionsManager& right) = delete;
 
   // methods
-  G4bool Iterate(G4double energyCut, G4double& lowerCut, G4double& higherCut,
-    G4double defaultRangeCut, G4double lowEdgeEnergy, G4double highEdgeEnergy,
-    G4int nbin, std::map<G4double, G4double>& map,
-    std::map<G4double, G4double>::const_iterator& it, G4Material* material,
-    G4VRangeToEnergyConverter& converter) const;
-
   std::pair<G4double,G4double>
-    ConvertEnergyToRange(G4double energyCut, G4Material* material,
-    G4VRangeToEnergyConverter& converter, G4double defaultRangeValue) const;
+    ConvertEnergyToRange(G4double energyCut, const G4Material* material,
+    G4VRangeToEnergyConverter& converter, G4double defaultRangeValue,
+    std::ostream& output) const;
 
   std::pair<G4double,G4double>
     GetRangeCut(G4double energyCut, G4Material* material,
     G4VRangeToEnergyConverter& converter, G4double defaultRangeValue) const;
 
+  void ConvertEnergyCuts(G4double cutEleGlobal, G4double cutGamGlobal,
+    G4double defaultRangeCutEle, G4double defaultRangeCutGam);
+
+  const TG4RegionData* FindLoadedData(const G4Material* material,
+    G4bool isGamma, G4double energyCut) const;
+  G4bool IsLoadedDataValid() const;
+  void PrintParameters(std::ostream& output) const override;
+
+  void MergeRegions();
+  G4int GetNofCouples() const;
+  G4double GetCoupleMemory(G4int& nofTables) const;
+
   void CheckRegionsRanges() const;
   void PrintFromMap(std::ostream& output) const;
 
@@ -133,8 +163,8 @@ class TG4RegionsManager : public TG4VRegionsManager
   static constexpr G4int fgkDefaultRangePrecision = 5;
   /// the default tolerance (relative) for comparing energy cut values
   static constexpr G4double fgkDefaultEnergyTolerance = 0.01;
-  /// the number of bins for search range iteration
-  static constexpr G4int fgkNofBins = 10;
+  /// the relative tolerance for comparing the loaded VMC cuts
+  static constexpr G4double fgkLoadTolerance = 1e-05;
   /// the minimum range order
   static constexpr G4int fgkMinRangeOrder = -3;
   /// the maximum range order
@@ -153,8 +183,26 @@ class TG4RegionsManager : public TG4VRegionsManager
   G4bool fIsG4Table = false;
   /// option to load regions ranges from a file
   G4bool fIsLoad = false;
+  /// the number of threads for converting cuts (0 = hardware threads)
+  G4int fNofThreads = 0;
+  /// the tolerance (relative) for merging regions (< 0 = no merging)
+  G4double fMergeTolerance = -1.;
+  /// the regions created in DefineRegions()
+  std::vector<G4Region*> fRegions;
   /// map for computed or loaded regions data
   std::map<G4String, TG4RegionData> fRegionData;
+  /// the default range cut for gamma used in DefineRegions()
+  G4double fDefaultRangeCutGam = 0.;
+  /// the default range cut for e- used in DefineRegions()
+  G4double fDefaultRangeCutEle = 0.;
+  /// the default range cut for gamma saved with the loaded data
+  G4double fLoadedRangeCutGam = -1.;
+  /// the default range cut for e- saved with the loaded data
+  G4double fLoadedRangeCutEle = -1.;
+  /// the range precision saved with the loaded data
+  G4int fLoadedRangePrecision = -1;
+  /// map for the cuts converted in ConvertEnergyCuts()
+  std::map<TG4CutKey, std::pair<G4double, G4double>> fConvertedCuts;
 };
 
 /// Set the precision for calculating ranges
@@ -177,6 +225,12 @@ inline void TG4RegionsManager::SetFromG4Table(G4bool isG4Table)
   fIsG4Table = isG4Table;
 }
 
+/// Set the number of threads for converting cuts (0 = hardware threads)
+inline void TG4RegionsManager::SetNofThreads(G4int nofThreads)
+{
+  fNofThreads = nofThreads;
+}
+
 /// Return the precision for calculating ranges
 inline G4int TG4RegionsManager::GetRangePrecision() const
 {
@@ -196,4 +250,19 @@ inline G4bool TG4RegionsManager::IsG4Table() const
 /// Return the option to load regions ranges from a file
 inline G4bool TG4RegionsManager::IsLoad() const { return fIsLoad; }
 
+/// Return the number of threads for converting cuts
+inline G4int TG4RegionsManager::GetNofThreads() const { return fNofThreads; }
+
+/// Set the tolerance (relative) for merging regions (< 0 = no merging)
+inline void TG4RegionsManager::SetMergeTolerance(G4double tolerance)
+{
+  fMergeTolerance = tolerance;
+}
+
+/// Return the tolerance (relative) for merging regions
+inline G4double TG4RegionsManager::GetMergeTolerance() const
+{
+  return fMergeTolerance;
+}
+
 #endif // TG4_REGIONS_MANAGER_H
@@ -47,6 +47,8 @@ class G4UIcmdWithABool;
 /// - /mcRegions/applyForProton true|false
 /// - /mcRegions/load [true|false]
 /// - /mcRegions/fromG4Table [true|false]
+/// - /mcRegions/setNofThreads value
+/// - /mcRegions/mergeRegions tolerance
 ///
 /// \author I. Hrivnacova; IPN, Orsay
 
@@ -101,6 +103,10 @@ class TG4RegionsMessenger : public G4UImessenger
   G4UIcmdWithABool* fSetLoadCmd = nullptr;
   /// command: /mcRegions/fromG4Table [true|false]
   G4UIcmdWithABool* fSetFromG4TableCmd = nullptr;
+  /// command: /mcRegions/setNofThreads value
+  G4UIcmdWithAnInteger* fSetNofThreadsCmd = nullptr;
+  /// command: /mcRegions/mergeRegions tolerance
+  G4UIcmdWithADouble* fMergeRegionsCmd = nullptr;
 };
 
 #endif // TG4_RUN_MESSENGER_H
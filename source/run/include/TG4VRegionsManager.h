@@ -97,6 +97,7 @@ class TG4VRegionsManager : public TG4Verbose
     const G4MaterialCutsCouple* couple, const G4Region* region) const;
 
   void CheckRegionsInGeometry() const;
+  virtual void PrintParameters(std::ostream& output) const;
   void PrintLegend(std::ostream& output) const;
   void PrintRegionData(std::ostream& output, const G4String& matName,
     const TG4RegionData& values) const;
@@ -131,6 +132,8 @@ class TG4VRegionsManager : public TG4Verbose
   G4bool fIsPrint = false;
   /// option to save all regions in a file
   G4bool fIsSave = false;
+  /// the names of the regions which the regions per material were merged in
+  std::map<G4String, G4String> fMergedRegionNames;
 };
 
 /// Return the singleton instance
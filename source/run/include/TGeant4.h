@@ -29,6 +29,7 @@ class TG4PhysicsManager;
 class TG4StepManager;
 class TG4VisManager;
 class TG4RunManager;
+struct TG4StepRecord;
 
 class G4VisExecutive;
 
@@ -304,6 +305,9 @@ class TGeant4 : public TVirtualMC
   virtual TMCProcess ProdProcess(Int_t isec) const;
   virtual Int_t StepProcesses(TArrayI& proc) const;
 
+  // step snapshot (G4 specific)
+  const TG4StepRecord& GetStepRecord(Int_t nofLevels = 1) const;
+
   //
   // methods for visualization
   // ------------------------------------------------
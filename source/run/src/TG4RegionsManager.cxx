@@ -23,9 +23,14 @@
 #include "TG4PhysicsManager.h"
 #include "TG4RegionsMessenger.h"
 
+#include <G4Electron.hh>
+#include <G4EmParameters.hh>
 #include <G4Gamma.hh>
 #include <G4LogicalVolumeStore.hh>
+#include <G4Positron.hh>
+#include <G4ProcessManager.hh>
 #include <G4ProductionCuts.hh>
+#include <G4Proton.hh>
 #include <G4RToEConvForElectron.hh>
 #include <G4RToEConvForGamma.hh>
 #include <G4Region.hh>
@@ -36,9 +41,13 @@
 #include <G4VUserPhysicsList.hh>
 #include <G4Version.hh>
 
+#include <algorithm>
+#include <cmath>
+#include <fstream>
 #include <map>
 #include <set>
-#include <fstream>
+#include <sstream>
+#include <thread>
 
 //_____________________________________________________________________________
 TG4RegionsManager::TG4RegionsManager()
@@ -50,153 +59,227 @@ TG4RegionsManager::TG4RegionsManager()
 //
 
 //_____________________________________________________________________________
-G4bool TG4RegionsManager::Iterate(G4double energyCut, G4double& lowerCut,
-  G4double& higherCut, G4double defaultRangeCut, G4double lowEdgeEnergy,
-  G4double highEdgeEnergy, G4int nbin,
-  std::map<G4double, G4double>& energyToRangeMap,
-  std::map<G4double, G4double>::const_iterator& it, G4Material* material,
-  G4VRangeToEnergyConverter& converter) const
+std::pair<G4double,G4double>
+TG4RegionsManager::ConvertEnergyToRange(G4double energyCut,
+  const G4Material* material, G4VRangeToEnergyConverter& converter,
+  G4double defaultRangeCut, std::ostream& output) const
 {
-  /// Helper function called from ConvertEnergyToRange() in each iteration
+  /// Estimate cut in range for given cut in energy.
+  /// The table of energies for the default range cut and the range orders
+  /// above it is built first; as the energy is monotonic with range, it is
+  /// inverted with a binary search and the found range order is then
+  /// refined by bisection.
+  /// The verbose messages are written in the given output stream.
 
-  G4double step = (higherCut - lowerCut) / nbin;
-  energyToRangeMap.clear();
+  G4double lowEdgeEnergy = converter.GetLowEdgeEnergy();
+  G4double highEdgeEnergy = converter.GetHighEdgeEnergy();
   G4String indent("     ");
-  for (G4int i = 0; i <= nbin; i++) {
-    G4double rangeCut = lowerCut + i * step;
-    if (rangeCut < defaultRangeCut) continue;
+
+  auto convert = [&](G4double rangeCut) {
     G4double energy = converter.Convert(rangeCut, material);
     if (VerboseLevel() > 2) {
-      G4cout << indent << "For range: " << rangeCut << " mm  got energy "
+      output << indent << "For range: " << rangeCut << " mm  got energy "
              << energy / MeV << " MeV" << G4endl;
     }
-
     if (energy < lowEdgeEnergy) energy = lowEdgeEnergy;
     if (energy > highEdgeEnergy) energy = highEdgeEnergy;
+    return energy / MeV;
+  };
 
-    energyToRangeMap.insert(
-      std::pair<G4double, G4double>(energy / MeV, rangeCut));
+  // Build the range to energy table for the default range cut and
+  // the range orders in between fgkMinRangeOrder and fgkMaxRangeOrder
+  // (1e-03mm, 1e-02, 1e-01, 1mm, 1cm, 10 cm, 1m, 10m, 100m, 1000m )
+  std::vector<G4double> ranges = { defaultRangeCut };
+  for (G4int i = fgkMinRangeOrder; i <= fgkMaxRangeOrder; i++) {
+    G4double rangeCut = pow(10., i);
+    if (rangeCut > defaultRangeCut) ranges.push_back(rangeCut);
+  }
+  std::vector<G4double> energies(ranges.size());
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    energies[i] = convert(ranges[i]);
   }
 
-  // Now find the closest value of energy
-  it = energyToRangeMap.lower_bound(energyCut);
-
-  if (it == energyToRangeMap.end()) {
+  // If energyCut is above the maximum range order return the last
+  // computed value
+  if (energies.back() < energyCut) {
     if (VerboseLevel() > 2) {
-      G4cout << indent << "Range  not found " << G4endl;
+      output << indent << "Outside range, return the highest value " << G4endl;
     }
-    return false;
+    return { energies.back(), ranges.back() };
   }
-  else {
-    if (VerboseLevel() > 2) {
-      G4cout << indent << "Found range limit: " << it->second << " mm"
-             << G4endl;
+
+  // Now find the first energy which is equal or higher than given energyCut
+  size_t index =
+    std::lower_bound(energies.begin(), energies.end(), energyCut) -
+    energies.begin();
+  if (index == 0) return { energies[0], ranges[0] };
+
+  if (VerboseLevel() > 2) {
+    output << indent << "Found range limit: " << ranges[index] << " mm"
+           << G4endl;
+  }
+
+  // Now refine the range by bisection; the number of iterations
+  // corresponds to the range precision in decimal digits
+  G4double lowerCut = ranges[index - 1];
+  G4double lowerEnergy = energies[index - 1];
+  G4double higherCut = ranges[index];
+  G4int nofIterations = G4int(std::ceil(fRangePrecision * std::log2(10.)));
+  for (G4int iteration = 0; iteration < nofIterations; ++iteration) {
+    G4double rangeCut = 0.5 * (lowerCut + higherCut);
+    G4double energy = convert(rangeCut);
+    if (energy < energyCut) {
+      lowerCut = rangeCut;
+      lowerEnergy = energy;
+    }
+    else {
+      higherCut = rangeCut;
     }
-    return true;
   }
+
+  // Return the range with the closest energy below the user cut value
+  return { lowerEnergy, lowerCut };
 }
 
 //_____________________________________________________________________________
-std::pair<G4double,G4double>
-TG4RegionsManager::ConvertEnergyToRange(G4double energyCut,
-  G4Material* material, G4VRangeToEnergyConverter& converter,
-  G4double defaultRangeCut) const
+void TG4RegionsManager::ConvertEnergyCuts(G4double cutEleGlobal,
+  G4double cutGamGlobal, G4double defaultRangeCutEle,
+  G4double defaultRangeCutGam)
 {
-  /// Estimate cut in range for given cut in energy.
-  /// Return negative value if range cut is not fount.
+  /// Convert the energy cuts of all materials which will be evaluated
+  /// in DefineRegions() (the first volume with a given material and
+  /// the world volume) in the pool of threads. Each thread uses its own
+  /// range to energy converters. G4cout is not used in the threads,
+  /// the verbose messages of each cut are collected and printed after
+  /// all threads have finished.
+
+  fConvertedCuts.clear();
+
+  // Collect the cuts to be converted
+  std::vector<TG4CutKey> keys;
+  std::set<G4Material*> materials;
+  G4LogicalVolume* worldLV =
+    TG4GeometryServices::Instance()->GetWorld()->GetLogicalVolume();
+  G4LogicalVolumeStore* lvStore = G4LogicalVolumeStore::GetInstance();
+  for (G4int i = 0; i < G4int(lvStore->size()); i++) {
+    G4LogicalVolume* lv = (*lvStore)[i];
+    if (!TG4GeometryServices::Instance()->GetMediumMap()->GetMedium(lv, false))
+      continue;
 
-  G4double lowEdgeEnergy = converter.GetLowEdgeEnergy();
-  G4double highEdgeEnergy = converter.GetHighEdgeEnergy();
+    G4Material* material = lv->GetMaterial();
+    if (!materials.insert(material).second && lv != worldLV) continue;
 
-  // First compute default energy cut
-  std::map<G4double, G4double> energyToRangeMap;
-  G4double energy = converter.Convert(defaultRangeCut, material);
-  if (energy < lowEdgeEnergy) energy = lowEdgeEnergy;
-  if (energy > highEdgeEnergy) energy = highEdgeEnergy;
-  energyToRangeMap.insert(
-    std::pair<G4double, G4double>(energy / MeV, defaultRangeCut));
+    TG4Limits* limits = (TG4Limits*)lv->GetUserLimits();
+    G4double cutEle = GetEnergyCut(limits, kCUTELE, cutEleGlobal);
+    G4double cutGam = GetEnergyCut(limits, kCUTGAM, cutGamGlobal);
 
-  // Compute the range order where we will start iterating
-  // withing the orders in between fgkMinRangeOrder and fgkMaxRangeOrder
-  // (1e-03mm, 1e-02, 1e-01, 1mm, 1cm, 10 cm, 1m, 10m, 100m, 1000m )
-  G4String indent("     ");
-  for (G4int i = fgkMinRangeOrder; i <= fgkMaxRangeOrder; i++) {
-    G4double rangeCut = pow(10., i);
-    if (rangeCut < defaultRangeCut) continue;
-    energy = converter.Convert(rangeCut, material);
-    if (VerboseLevel() > 2) {
-      G4cout << indent << "For range: " << std::setw(5) << rangeCut
-             << " mm  got energy " << energy / MeV << " MeV" << G4endl;
+    if (cutEle != DBL_MAX && !FindLoadedData(material, false, cutEle)) {
+      keys.emplace_back(G4Electron::Definition(), material, cutEle);
+    }
+    if (cutGam != DBL_MAX && !FindLoadedData(material, true, cutGam)) {
+      keys.emplace_back(G4Gamma::Definition(), material, cutGam);
     }
-
-    if (energy < lowEdgeEnergy) energy = lowEdgeEnergy;
-    if (energy > highEdgeEnergy) energy = highEdgeEnergy;
-    energyToRangeMap.insert(
-      std::pair<G4double, G4double>(energy / MeV, rangeCut));
   }
 
-  // If energyCut is above the maximum range order return the last
-  // computed value
-  if (energyToRangeMap.rbegin()->first < energyCut) {
-    if (VerboseLevel() > 2) {
-      G4cout << indent << "Outside range, return the highest value " << G4endl;
+  G4int nofKeys = keys.size();
+  if (!nofKeys) return;
+
+  G4int nofThreads = fNofThreads;
+  if (nofThreads <= 0) nofThreads = std::thread::hardware_concurrency();
+  nofThreads = std::min(nofThreads, nofKeys);
+  if (nofThreads < 1) nofThreads = 1;
+
+  std::vector<std::pair<G4double, G4double>> results(nofKeys);
+  std::vector<std::string> messages(nofKeys);
+  auto convert = [&](G4int first, G4int last) {
+    // Create G4 range to energy converters
+#if (G4VERSION_NUMBER == 1100 || G4VERSION_NUMBER == 1101)
+    // Temporary work-around for a bug in G4VRangeToEnergyConverter
+    auto& converterEle = *(new G4RToEConvForElectron());
+    auto& converterGam = *(new G4RToEConvForGamma());
+#else
+    G4RToEConvForElectron converterEle;
+    G4RToEConvForGamma converterGam;
+#endif
+    for (G4int i = first; i < last; ++i) {
+      auto [particle, material, energyCut] = keys[i];
+      G4bool isGamma = (particle == G4Gamma::Definition());
+      std::ostringstream output;
+      results[i] = ConvertEnergyToRange(energyCut, material,
+        isGamma ? static_cast<G4VRangeToEnergyConverter&>(converterGam)
+                : static_cast<G4VRangeToEnergyConverter&>(converterEle),
+        isGamma ? defaultRangeCutGam : defaultRangeCutEle, output);
+      messages[i] = output.str();
     }
-    return *(energyToRangeMap.rbegin());
+  };
+
+  G4int chunk = (nofKeys + nofThreads - 1) / nofThreads;
+  std::vector<std::thread> threads;
+  for (G4int i = 1; i < nofThreads; ++i) {
+    threads.emplace_back(
+      convert, i * chunk, std::min(nofKeys, (i + 1) * chunk));
   }
+  convert(0, std::min(nofKeys, chunk));
+  for (auto& thread : threads) thread.join();
 
-  // Now find the closest value of energy which is
-  // equal or higher than given energyCut
-  std::map<G4double, G4double>::const_iterator it =
-    energyToRangeMap.lower_bound(energyCut);
+  for (G4int i = 0; i < nofKeys; ++i) {
+    fConvertedCuts[keys[i]] = results[i];
+    if (!messages[i].empty()) G4cout << messages[i];
+  }
 
-  if (it == energyToRangeMap.end()) {
-    if (VerboseLevel() > 2) {
-      G4cout << indent << "Range not found " << G4endl;
-    }
-    return {-1.0, -1.0};
+  if (VerboseLevel() > 0) {
+    G4cout << "Converted " << nofKeys << " energy cuts with " << nofThreads
+           << " threads" << G4endl;
   }
+}
 
-  if (VerboseLevel() > 2) {
-    G4cout << indent << "Found range limit: " << it->second << " mm" << G4endl;
-  }
-
-  // Now iterate up to desired precision of range
-  G4int iteration = 0;
-  while (iteration < fRangePrecision) {
-    G4int nbin = fgkNofBins;
-    if (iteration == 0) --nbin;
-
-    auto higherCutIt = it;
-    auto higherCut = it->second;
-    // G4cout << "higherCut = " << higherCut << G4endl;
-    if (it == energyToRangeMap.begin()) return *higherCutIt;
-
-    --it;
-    auto lowerCutIt = it;
-    auto lowerCut = it->second;
-    // G4cout << "lowerCut = " << lowerCut << G4endl;
-    G4bool found =
-      Iterate(energyCut, lowerCut, higherCut, defaultRangeCut, lowEdgeEnergy,
-        highEdgeEnergy, nbin, energyToRangeMap, it, material, converter);
-
-    if (!found) {
-      // Now we have to go one step back to get below the user cut value
-      // unless we are at the beginning of the map
-      if (it == energyToRangeMap.begin()) return *higherCutIt;
-      --it;
-      return *it;
-      ;
-    }
-    ++iteration;
+//_____________________________________________________________________________
+const TG4RegionsManager::TG4RegionData* TG4RegionsManager::FindLoadedData(
+  const G4Material* material, G4bool isGamma, G4double energyCut) const
+{
+  /// Return the loaded region data for the given material if the VMC
+  /// energy cut saved with the data is equal to the given energy cut
+  /// and the data were computed with the current default range cuts
+  /// and range precision; return nullptr otherwise.
+
+  if (!fIsLoad || !IsLoadedDataValid()) return nullptr;
+
+  auto it = fRegionData.find(material->GetName());
+  if (it == fRegionData.end()) return nullptr;
+
+  G4double loadedCut =
+    isGamma ? it->second[fgkVmcCutGamIdx] : it->second[fgkVmcCutEleIdx];
+  if (fabs(loadedCut - energyCut) > fgkLoadTolerance * energyCut) {
+    return nullptr;
   }
 
-  // Now we have to go one step back to get below the user cut value
-  // unless we are at the beginning of the map
-  // if (it == energyToRangeMap.begin()) return it->second;
-  if (it == energyToRangeMap.begin()) return *it;
-  --it;
-  return *it;
-  ;
+  return &it->second;
+}
+
+//_____________________________________________________________________________
+G4bool TG4RegionsManager::IsLoadedDataValid() const
+{
+  /// Return true if the default range cuts and the range precision saved
+  /// with the loaded data are equal to those used in DefineRegions()
+
+  return fLoadedRangePrecision == fRangePrecision &&
+         fabs(fLoadedRangeCutGam - fDefaultRangeCutGam) <=
+           fgkLoadTolerance * fDefaultRangeCutGam &&
+         fabs(fLoadedRangeCutEle - fDefaultRangeCutEle) <=
+           fgkLoadTolerance * fDefaultRangeCutEle;
+}
+
+//_____________________________________________________________________________
+void TG4RegionsManager::PrintParameters(std::ostream& output) const
+{
+  /// Print the default range cuts (gamma, e-) and the range precision
+  /// used to compute the regions data; this line is read back
+  /// in LoadRegions()
+
+  output << "#parameters; " << std::scientific
+         << TG4PhysicsManager::Instance()->GetCutForGamma() << "  "
+         << std::scientific << TG4PhysicsManager::Instance()->GetCutForElectron()
+         << "  " << fRangePrecision << G4endl;
 }
 
 //_____________________________________________________________________________
@@ -221,32 +304,33 @@ TG4RegionsManager::GetRangeCut(G4double energyCut,
            << ": energy cut = " << energyCut << " MeV" << G4endl;
   }
 
-  if (fIsLoad) {
-    auto it = fRegionData.find(material->GetName());
-    if (it != fRegionData.end()) {
-      auto [rangeCut, energyCut] =
-        (converter.GetParticleType() == G4Gamma::Definition()) ?
-          std::pair(it->second[fgkRangeGamIdx], it->second[fgkCutGamIdx]) :
-          std::pair(it->second[fgkRangeEleIdx], it->second[fgkCutEleIdx]);
+  G4bool isGamma = (converter.GetParticleType() == G4Gamma::Definition());
+  auto loadedData = FindLoadedData(material, isGamma, energyCut);
+  if (loadedData) {
+    auto [rangeCut, cut] = isGamma ?
+      std::pair((*loadedData)[fgkRangeGamIdx], (*loadedData)[fgkCutGamIdx]) :
+      std::pair((*loadedData)[fgkRangeEleIdx], (*loadedData)[fgkCutEleIdx]);
 
-      if (VerboseLevel() > 1) {
-        G4cout << "  " << converter.GetParticleType()->GetParticleName()
-               << " loaded range, cut values: "
-               << rangeCut << ", " << energyCut << G4endl;
-      }
-      return {energyCut, rangeCut};
-    }
-    else {
-      if (VerboseLevel() > 1) {
-        G4cout << "  " << converter.GetParticleType()->GetParticleName()
-               << " rangeCut not found, keeping default range" << G4endl;
-      }
-      return {converter.GetLowEdgeEnergy(), defaultRangeCut};
+    if (VerboseLevel() > 1) {
+      G4cout << "  " << converter.GetParticleType()->GetParticleName()
+             << " loaded range, cut values: "
+             << rangeCut << ", " << cut << G4endl;
     }
+    return {cut, rangeCut};
   }
 
-  auto [calcEnergyCut, rangeCut]  =
-    ConvertEnergyToRange(energyCut, material, converter, defaultRangeCut);
+  if (fIsLoad && VerboseLevel() > 1) {
+    G4cout << "  " << converter.GetParticleType()->GetParticleName()
+           << " no loaded data for this energy cut, converting" << G4endl;
+  }
+
+  // Get the cut converted in ConvertEnergyCuts()
+  auto it = fConvertedCuts.find(
+    TG4CutKey(converter.GetParticleType(), material, energyCut));
+  auto [calcEnergyCut, rangeCut] = (it != fConvertedCuts.end()) ?
+    it->second :
+    ConvertEnergyToRange(
+      energyCut, material, converter, defaultRangeCut, G4cout);
 
   if (rangeCut < 0.) {
     if (VerboseLevel() > 1) {
@@ -328,6 +412,148 @@ void TG4RegionsManager::PrintFromMap(std::ostream& output) const
 }
 
 
+//_____________________________________________________________________________
+void TG4RegionsManager::MergeRegions()
+{
+  /// Merge the regions created in DefineRegions() which range cuts are
+  /// equal within fMergeTolerance (relative) in the default region or
+  /// in the first region with such cuts. The root logical volumes of the
+  /// merged region are moved in the target region and the merged region
+  /// is deleted together with its production cuts. The numbers of regions
+  /// and material-cuts couples before and after merging and the estimated
+  /// saved memory of physics tables are printed.
+
+  G4Region* defaultRegion =
+    G4RegionStore::GetInstance()->GetRegion(fgkDefaultRegionName, false);
+
+  G4int nofRegions = fRegions.size();
+  G4int nofCouples = GetNofCouples();
+
+  auto isEqual = [this](const G4ProductionCuts* cuts1,
+                   const G4ProductionCuts* cuts2) {
+    for (G4int i = 0; i < 4; ++i) {
+      G4double cut1 = cuts1->GetProductionCut(i);
+      G4double cut2 = cuts2->GetProductionCut(i);
+      if (fabs(cut1 - cut2) > fMergeTolerance * std::max(cut1, cut2)) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  std::vector<G4Region*> targets;
+  if (defaultRegion) targets.push_back(defaultRegion);
+
+  auto it = fRegions.begin();
+  while (it != fRegions.end()) {
+    G4Region* region = *it;
+    // Find the target region with equal cuts
+    G4Region* target = nullptr;
+    for (auto candidate : targets) {
+      if (isEqual(
+            region->GetProductionCuts(), candidate->GetProductionCuts())) {
+        target = candidate;
+        break;
+      }
+    }
+
+    if (!target) {
+      targets.push_back(region);
+      ++it;
+      continue;
+    }
+
+    if (VerboseLevel() > 1) {
+      G4cout << "   "
+             << "merging region " << region->GetName() << " in region "
+             << target->GetName() << G4endl;
+    }
+
+    // Move the root volumes in the target region
+    auto rootVolumesIt = region->GetRootLogicalVolumeIterator();
+    std::vector<G4LogicalVolume*> rootVolumes(
+      rootVolumesIt, rootVolumesIt + region->GetNumberOfRootVolumes());
+    for (auto lv : rootVolumes) {
+      region->RemoveRootLogicalVolume(lv);
+      target->AddRootLogicalVolume(lv);
+    }
+    fMergedRegionNames[region->GetName()] = target->GetName();
+
+    // Remove the merged region from the regions list before deleting it
+    it = fRegions.erase(it);
+    delete region->GetProductionCuts();
+    delete region;
+  }
+
+  G4int nofMergedCouples = GetNofCouples();
+  G4int nofTables = 0;
+  G4double coupleMemory = GetCoupleMemory(nofTables);
+  G4int nofSavedCouples = nofCouples - nofMergedCouples;
+
+  if (VerboseLevel() > 0) {
+    G4cout << "Merged regions with tolerance " << fMergeTolerance << G4endl
+           << "   Number of regions:        " << nofRegions << " -> "
+           << fRegions.size() << G4endl
+           << "   Number of couples:        " << nofCouples << " -> "
+           << nofMergedCouples << G4endl
+           << "   Saved physics tables:     " << nofSavedCouples * nofTables
+           << " (estimated, " << nofTables << " per couple)" << G4endl
+           << "   Saved memory:             "
+           << nofSavedCouples * coupleMemory / 1024. / 1024. << " MB"
+           << " (estimated)" << G4endl;
+  }
+}
+
+//_____________________________________________________________________________
+G4int TG4RegionsManager::GetNofCouples() const
+{
+  /// Return the number of material-cuts couples which will be created
+  /// for the current regions (the distinct pairs of the material and
+  /// the production cuts over all regions)
+
+  std::set<std::pair<const G4Material*, const G4ProductionCuts*>> couples;
+  for (auto region : *G4RegionStore::GetInstance()) {
+    region->UpdateMaterialList();
+    auto itm = region->GetMaterialIterator();
+    for (size_t i = 0; i < region->GetNumberOfMaterials(); ++i, ++itm) {
+      couples.insert(std::make_pair(*itm, region->GetProductionCuts()));
+    }
+  }
+
+  return couples.size();
+}
+
+//_____________________________________________________________________________
+G4double TG4RegionsManager::GetCoupleMemory(G4int& nofTables) const
+{
+  /// Return the estimated memory (in bytes) of the physics tables per
+  /// material-cuts couple and the number of these tables; two tables
+  /// are assumed per each electromagnetic process of gamma, e-, e+
+  /// and proton, each with the energy, the value and the second derivative
+  /// in all energy bins.
+
+  auto emParameters = G4EmParameters::Instance();
+  G4int nofBins = G4int(emParameters->NumberOfBinsPerDecade() *
+                        std::log10(emParameters->MaxKinEnergy() /
+                                   emParameters->MinKinEnergy())) + 1;
+
+  nofTables = 0;
+  for (auto particle : { G4Gamma::Definition(), G4Electron::Definition(),
+         G4Positron::Definition(), G4Proton::Definition() }) {
+    auto processManager = particle->GetProcessManager();
+    if (!processManager) continue;
+
+    auto processVector = processManager->GetProcessList();
+    for (size_t i = 0; i < processVector->length(); ++i) {
+      if ((*processVector)[i]->GetProcessType() == fElectromagnetic) {
+        nofTables += 2;
+      }
+    }
+  }
+
+  return nofTables * nofBins * 3. * sizeof(G4double);
+}
+
 //
 // public methods
 //
@@ -347,6 +573,10 @@ void TG4RegionsManager::DefineRegions()
     G4cout << "Converting VMC cuts in regions" << G4endl;
   }
 
+  // Forget the regions from a previous call
+  fRegions.clear();
+  fMergedRegionNames.clear();
+
   if (fIsLoad) {
     LoadRegions();
   }
@@ -371,6 +601,15 @@ void TG4RegionsManager::DefineRegions()
     TG4PhysicsManager::Instance()->GetCutForPositron();
   G4double defaultRangeCutProton =
     TG4PhysicsManager::Instance()->GetCutForProton();
+  fDefaultRangeCutGam = defaultRangeCutGam;
+  fDefaultRangeCutEle = defaultRangeCutEle;
+
+  if (fIsLoad && !IsLoadedDataValid()) {
+    TG4Globals::Warning("TG4RegionsManager", "DefineRegions",
+      "The loaded regions data were not computed with the current default "
+      "range cuts and range precision." + TG4Globals::Endl() +
+      "All energy cuts will be converted.");
+  }
 
   // Create a new region with default cuts
   G4Region* defaultRegion = new G4Region(fgkDefaultRegionName);
@@ -395,6 +634,10 @@ void TG4RegionsManager::DefineRegions()
            << "  CUTGAM = " << cutGamGlobal << " MeV" << G4endl;
   }
 
+  // Convert energy cuts of all materials in parallel
+  ConvertEnergyCuts(
+    cutEleGlobal, cutGamGlobal, defaultRangeCutEle, defaultRangeCutGam);
+
   G4int counter = 0;
   std::set<G4Material*> processedMaterials;
   std::set<G4Material*> processedMaterials2;
@@ -517,11 +760,9 @@ void TG4RegionsManager::DefineRegions()
         cuts->SetProductionCut(defaultRangeCutProton, 2);
       }
 
-      // save computed ranges in a map
-      if (! fIsLoad) {
-        fRegionData[regionName] =
-          {rangeGam, rangeEle, calcCutGam, calcCutEle, cutGam, cutEle};
-      }
+      // save computed or loaded ranges in a map
+      fRegionData[regionName] =
+        {rangeGam, rangeEle, calcCutGam, calcCutEle, cutGam, cutEle};
 
       if (isWorld) {
         // set new production cuts to the world
@@ -538,6 +779,7 @@ void TG4RegionsManager::DefineRegions()
       // Create new region if it does not yet exist
       if (region == nullptr) {
         region = new G4Region(regionName);
+        fRegions.push_back(region);
         ++counter;
         which = "new ";
       }
@@ -560,6 +802,11 @@ void TG4RegionsManager::DefineRegions()
   if (VerboseLevel() > 0) {
     G4cout << "Number of added regions: " << counter << G4endl;
   }
+
+  // Merge regions with equal cuts (within tolerance)
+  if (fMergeTolerance >= 0.) {
+    MergeRegions();
+  }
 }
 
 //_____________________________________________________________________________
@@ -613,11 +860,26 @@ void TG4RegionsManager::LoadRegions()
 
   G4String skipLine;
   G4String regionName;
-  G4int counter;
+  G4int counter = 0;
   TG4RegionData regionValues;
 
-  // skip comments
+  // read the parameters, if present, and skip comments
+  fLoadedRangeCutGam = -1.;
+  fLoadedRangeCutEle = -1.;
+  fLoadedRangePrecision = -1;
+  G4String parametersTag("#parameters;");
   std::getline(input, skipLine);
+  if (skipLine.compare(0, parametersTag.size(), parametersTag) == 0) {
+    std::istringstream parameters(skipLine.substr(parametersTag.size()));
+    parameters >> fLoadedRangeCutGam >> fLoadedRangeCutEle >>
+      fLoadedRangePrecision;
+    std::getline(input, skipLine);
+  }
+  else {
+    TG4Globals::Warning("TG4RegionsManager", "LoadRegions",
+      "The input file " + TString(fileName.data()) +
+        " does not define the default range cuts and range precision.");
+  }
 
   // read data
   while (! input.eof()) {
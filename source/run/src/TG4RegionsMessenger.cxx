@@ -60,6 +60,8 @@ TG4RegionsMessenger::~TG4RegionsMessenger()
   delete fApplyForProtonCmd;
   delete fSetLoadCmd;
   delete fSetFromG4TableCmd;
+  delete fSetNofThreadsCmd;
+  delete fMergeRegionsCmd;
 }
 
 //
@@ -152,6 +154,24 @@ void TG4RegionsMessenger::CreateCommands()
       "Must be called before \"print\" or \"save\" command.");
     fSetFromG4TableCmd->SetParameterName("IsFromG4Table", false);
     fSetFromG4TableCmd->AvailableForStates(G4State_PreInit, G4State_Init);
+
+    fSetNofThreadsCmd =
+      new G4UIcmdWithAnInteger("/mcRegions/setNofThreads", this);
+    fSetNofThreadsCmd->SetGuidance(
+      "Set the number of threads for converting energy cuts in ranges;");
+    fSetNofThreadsCmd->SetGuidance(
+      "0 = number of hardware threads (default), 1 = sequential conversion");
+    fSetNofThreadsCmd->SetParameterName("NofThreads", false);
+    fSetNofThreadsCmd->SetRange("NofThreads >= 0");
+    fSetNofThreadsCmd->AvailableForStates(G4State_PreInit, G4State_Init);
+
+    fMergeRegionsCmd = new G4UIcmdWithADouble("/mcRegions/mergeRegions", this);
+    fMergeRegionsCmd->SetGuidance(
+      "Merge regions which range cuts are equal within the given tolerance");
+    fMergeRegionsCmd->SetGuidance(
+      "(relative) in shared regions; negative value switches merging off.");
+    fMergeRegionsCmd->SetParameterName("Tolerance", false);
+    fMergeRegionsCmd->AvailableForStates(G4State_PreInit, G4State_Init);
   }
 }
 
@@ -269,6 +289,16 @@ void TG4RegionsMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
         fSetFromG4TableCmd->GetNewBoolValue(newValue));
       return;
     }
+    if (command == fSetNofThreadsCmd) {
+      fRegionsManager->SetNofThreads(
+        fSetNofThreadsCmd->GetNewIntValue(newValue));
+      return;
+    }
+    if (command == fMergeRegionsCmd) {
+      fRegionsManager->SetMergeTolerance(
+        fMergeRegionsCmd->GetNewDoubleValue(newValue));
+      return;
+    }
     if (command == fSetFileNameCmd) {
       fRegionsManager->SetFileName(newValue);
     }
@@ -16,9 +16,12 @@
 // in order to avoid the odd dependency for the
 // times system function this include must be the first
 
+#include "TG4GeometryManager.h"
 #include "TG4Globals.h"
 #include "TG4VRegionsManager.h"
 #include "TG4RunAction.h"
+#include "TG4StepManager.h"
+#include "TG4StepProfiler.h"
 #include "TGeant4.h"
 
 #include <G4AutoLock.hh>
@@ -32,6 +35,8 @@
 #include <G4UImanager.hh>
 #include <Randomize.hh>
 
+#include <TG4RootNavMgr.h>
+#include <TG4RootNavigator.h>
 #include <TObjArray.h>
 
 // mutex in a file scope
@@ -167,6 +172,11 @@ void TG4RunAction::BeginOfRunAction(const G4Run* run)
     G4cout << "### Run " << run->GetRunID() << " start." << G4endl;
   }
 
+  // prepare the cross section batch jobs (they are filled at the end of run)
+  if (IsMaster()) {
+    fCrossSectionManager.PrepareBatch();
+  }
+
   auto regionsManager = TG4VRegionsManager::Instance();
   if (regionsManager != nullptr) {
     if (regionsManager->IsCheck()) {
@@ -227,6 +237,9 @@ void TG4RunAction::EndOfRunAction(const G4Run* run)
     TGeant4::MasterApplicationInstance()->Merge(
       TVirtualMCApplication::Instance());
     lm.unlock();
+
+    // Merge field statistics
+    TG4GeometryManager::Instance()->MergeFieldStatistics();
   }
 #endif
 
@@ -234,6 +247,13 @@ void TG4RunAction::EndOfRunAction(const G4Run* run)
     fCrossSectionManager.MakeHistograms();
   }
 
+  // Fill the cross section batch jobs (distributed over workers)
+  // and write the histograms on master
+  TG4CrossSectionManager::FillBatch();
+  if (IsMaster()) {
+    fCrossSectionManager.WriteBatch();
+  }
+
   fTimer->Stop();
 
   if (VerboseLevel() > 0) {
@@ -241,4 +261,27 @@ void TG4RunAction::EndOfRunAction(const G4Run* run)
     G4cout << "Number of events processed: " << run->GetNumberOfEvent()
            << G4endl;
   }
+
+  if (VerboseLevel() > 1 && TG4StepManager::Instance()) {
+    TG4StepManager::Instance()->PrintVolPathCacheStatistics();
+  }
+
+  // Merge the step profiler tables (on workers or in sequential mode)
+  // and print the report on master
+  if (TG4StepProfiler::Instance()) {
+    TG4StepProfiler::Instance()->Merge();
+  }
+  if (IsMaster()) {
+    TG4StepProfiler::PrintReport();
+  }
+
+  // Merge the Root navigator statistics (on workers or in sequential mode)
+  // and print them on master
+  TG4RootNavMgr* rootNavMgr = TG4RootNavMgr::GetInstance();
+  if (rootNavMgr && rootNavMgr->GetNavigator()) {
+    rootNavMgr->GetNavigator()->MergeStatistics();
+  }
+  if (IsMaster()) {
+    TG4RootNavigator::PrintStatistics();
+  }
 }
@@ -153,6 +153,11 @@ void TG4VRegionsManager::CheckRegionsInGeometry() const
       TG4GeometryServices::Instance()->GetMediumMap()->GetMedium(lv, false);
     if (!medium) continue;
 
+    // region per material merged in another region
+    auto it = fMergedRegionNames.find(lv->GetMaterial()->GetName());
+    if (it != fMergedRegionNames.end() &&
+        lv->GetRegion()->GetName() == it->second) continue;
+
     if (lv->GetRegion()->GetName() != lv->GetMaterial()->GetName() &&
         lv->GetRegion()->GetName() != fgkDefaultRegionName) {
 
@@ -173,6 +178,13 @@ void TG4VRegionsManager::CheckRegionsInGeometry() const
   }
 }
 
+//_____________________________________________________________________________
+void TG4VRegionsManager::PrintParameters(std::ostream& /*output*/) const
+{
+  /// Print the parameters of the regions data in the saved file;
+  /// nothing is printed by default
+}
+
 //_____________________________________________________________________________
 void TG4VRegionsManager::PrintLegend(std::ostream& output) const
 {
@@ -314,6 +326,7 @@ void TG4VRegionsManager::SaveRegions()
     G4cout << "Saving regions from production cuts table in file: " << fileName << G4endl;
   }
 
+  PrintParameters(fileOutput);
   PrintRegions(fileOutput);
   fileOutput.close();
 }